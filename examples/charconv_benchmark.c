@@ -0,0 +1,108 @@
+/*  GCC example build command
+
+gcc -Wall -Wextra -Werror -std=c99 -O2 examples/charconv_benchmark.c -o a.out
+
+Parses comma separated text of integers and of doubles, once field by field
+with strtoll / strtod and once with weu_charconv_parseIntArray and
+weu_charconv_parseDoubleArray straight into typed arrays.
+First checks weu_charconv_parseUInt and weu_charconv_parseUIntArray on values
+around UINT64_MAX, including twenty digit values that wrap past 2^64.
+*/
+
+#define WEU_IMPLEMENTATION
+#include "../include/weu/weu_stringbuilder.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define NUMBER_COUNT 2000000
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+typedef struct UIntCase { const char *text; weu_charconvStatus status; uint64_t value; } UIntCase;
+
+int main() {
+    const UIntCase uintCases[] = {
+        {"18446744073709551615",    WEU_CHARCONV_OK,            UINT64_MAX},
+        {"018446744073709551615",   WEU_CHARCONV_OK,            UINT64_MAX},
+        {"10000000000000000000",    WEU_CHARCONV_OK,            10000000000000000000ull},
+        {"18446744073709551616",    WEU_CHARCONV_OUT_OF_RANGE,  0},
+        {"28446744073709551616",    WEU_CHARCONV_OUT_OF_RANGE,  0},
+        {"36893488147419103231",    WEU_CHARCONV_OUT_OF_RANGE,  0},
+        {"99999999999999999999",    WEU_CHARCONV_OUT_OF_RANGE,  0},
+        {"100000000000000000000",   WEU_CHARCONV_OUT_OF_RANGE,  0},
+    };
+    uint32_t caseCount = sizeof(uintCases) / sizeof(uintCases[0]), casesPassed = 0;
+    for (uint32_t i = 0; i < caseCount; i++) {
+        uint64_t value = 0, arrayValue = 0;
+        uint32_t length = (uint32_t)strlen(uintCases[i].text), parsed;
+        weu_charconvStatus status = weu_charconv_parseUInt(uintCases[i].text, length, &value, NULL);
+        weu_charconvStatus arrayStatus = weu_charconv_parseUIntArray(uintCases[i].text, length, ',', &arrayValue, 1, &parsed, NULL);
+        bool passed = status == uintCases[i].status && arrayStatus == uintCases[i].status;
+        if (uintCases[i].status == WEU_CHARCONV_OK) passed = passed && value == uintCases[i].value && arrayValue == uintCases[i].value;
+        if (!passed) printf("parseUInt %s failed | status %d %d | value %llu %llu\n", uintCases[i].text, status, arrayStatus,
+            (unsigned long long)value, (unsigned long long)arrayValue);
+        casesPassed += passed;
+    }
+    printf("parseUInt edge cases %u / %u passed\n", casesPassed, caseCount);
+
+    weu_stringBuilder *builder = weu_stringBuilder_new(0);
+    for (uint32_t i = 0; i < NUMBER_COUNT; i++) {
+        weu_stringBuilder_appendInt(builder, (int64_t)(i * 2654435761u) - 2000000000);
+        weu_stringBuilder_appendChar(builder, i % 10 == 9 ? '\n' : ',');
+    }
+    weu_string *ints = weu_stringBuilder_toString(builder);
+    weu_stringBuilder_clear(builder);
+    for (uint32_t i = 0; i < NUMBER_COUNT; i++) {
+        weu_stringBuilder_appendFloat(builder, (i * 2654435761u) * 1e-6);
+        weu_stringBuilder_appendChar(builder, i % 10 == 9 ? '\n' : ',');
+    }
+    weu_string *doubles = weu_stringBuilder_toString(builder);
+    weu_stringBuilder_free(&builder);
+
+    int64_t *intValues = (int64_t*)malloc(sizeof(int64_t) * NUMBER_COUNT);
+    double *doubleValues = (double*)malloc(sizeof(double) * NUMBER_COUNT);
+    double checksum = 0;
+
+    clock_t start = clock();
+    char *end = ints->text;
+    for (uint32_t i = 0; i < NUMBER_COUNT; i++) {
+        intValues[i] = strtoll(end, &end, 10);
+        ++end;
+    }
+    double strtollTime = secondsSince(start);
+    checksum += (double)intValues[NUMBER_COUNT - 1];
+
+    start = clock();
+    uint32_t intCount;
+    weu_charconv_parseIntArray(ints->text, ints->length, ',', intValues, NUMBER_COUNT, &intCount, NULL);
+    double intArrayTime = secondsSince(start);
+    checksum += (double)intValues[NUMBER_COUNT - 1];
+
+    start = clock();
+    end = doubles->text;
+    for (uint32_t i = 0; i < NUMBER_COUNT; i++) {
+        doubleValues[i] = strtod(end, &end);
+        ++end;
+    }
+    double strtodTime = secondsSince(start);
+    checksum += doubleValues[NUMBER_COUNT - 1];
+
+    start = clock();
+    uint32_t doubleCount;
+    weu_charconv_parseDoubleArray(doubles->text, doubles->length, ',', doubleValues, NUMBER_COUNT, &doubleCount, NULL);
+    double doubleArrayTime = secondsSince(start);
+    checksum += doubleValues[NUMBER_COUNT - 1];
+
+    printf("int    %5.1f MB | strtoll %6.1f ns | parseIntArray    %6.1f ns | parsed %u\n", ints->length * 1e-6,
+        strtollTime * 1e9 / NUMBER_COUNT, intArrayTime * 1e9 / NUMBER_COUNT, intCount);
+    printf("double %5.1f MB | strtod  %6.1f ns | parseDoubleArray %6.1f ns | parsed %u | checksum %g\n", doubles->length * 1e-6,
+        strtodTime * 1e9 / NUMBER_COUNT, doubleArrayTime * 1e9 / NUMBER_COUNT, doubleCount, checksum);
+    free(intValues);
+    free(doubleValues);
+    weu_string_free(&ints);
+    weu_string_free(&doubles);
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*  GCC example build command
+
+gcc -Wall -Wextra -Werror -std=c99 -O2 examples/concurrenthashtable_benchmark.c -o a.out -pthread
+
+Read heavy workload (95% get, 5% add or remove) on random keys.
+Compares weu_hashTable behind one global mutex with weu_concurrentHashTable.
+*/
+
+#define _POSIX_C_SOURCE 200112L
+#define WEU_IMPLEMENTATION
+#include "../include/weu/weu_concurrenthashtable.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define KEY_COUNT       (1 << 20)
+#define OPS_PER_THREAD  2000000
+#define MAX_THREADS     32
+
+static char keys[KEY_COUNT][24];
+static uint32_t keyLengths[KEY_COUNT];
+
+static weu_hashTable *lockedTable;
+static pthread_mutex_t globalLock = PTHREAD_MUTEX_INITIALIZER;
+static weu_concurrentHashTable *concurrentTable;
+
+typedef struct benchmarkThread {
+    pthread_t thread;
+    uint64_t rng, hits;
+    bool concurrent;
+} benchmarkThread;
+
+static inline uint64_t nextRandom(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void *worker(void *data) {
+    benchmarkThread *self = (benchmarkThread*)data;
+    for (uint32_t i = 0; i < OPS_PER_THREAD; i++) {
+        uint64_t r = nextRandom(&self->rng);
+        uint32_t k = (uint32_t)(r >> 12) & (KEY_COUNT - 1);
+        uint32_t op = (uint32_t)(r % 100);
+        void *value = NULL;
+        if (self->concurrent) {
+            if (op < 95)        self->hits += weu_concurrentHashTable_get(concurrentTable, keys[k], keyLengths[k], &value) == WEU_HASH_OK;
+            else if (op & 1)    weu_concurrentHashTable_add(concurrentTable, keys[k], keyLengths[k], (void*)(uintptr_t)(k + 1));
+            else                weu_concurrentHashTable_remove(concurrentTable, keys[k], keyLengths[k]);
+        } else {
+            pthread_mutex_lock(&globalLock);
+            if (op < 95)        self->hits += weu_hashtable_getText(lockedTable, keys[k], keyLengths[k], &value) == WEU_HASH_OK;
+            else if (op & 1)    weu_hashtable_addText(lockedTable, keys[k], keyLengths[k], (void*)(uintptr_t)(k + 1));
+            else                weu_hashtable_removeText(lockedTable, keys[k], keyLengths[k]);
+            pthread_mutex_unlock(&globalLock);
+        }
+    }
+    return NULL;
+}
+
+static double run(uint32_t threadCount, bool concurrent) {
+    benchmarkThread threads[MAX_THREADS];
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < threadCount; i++) {
+        threads[i] = (benchmarkThread){.rng = 0x9e3779b97f4a7c15ULL * (i + 1), .hits = 0, .concurrent = concurrent};
+        pthread_create(&threads[i].thread, NULL, worker, &threads[i]);
+    }
+    for (uint32_t i = 0; i < threadCount; i++) pthread_join(threads[i].thread, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+    return (double)threadCount * OPS_PER_THREAD / seconds * 1e-6;
+}
+
+int main() {
+    lockedTable     = weu_hashtable_newDesc(&(weu_hashTableDesc){.engine = WEU_HASHENGINE_GROUP});
+    concurrentTable = weu_concurrentHashTable_new(0, NULL);
+    for (uint32_t i = 0; i < KEY_COUNT; i++) {
+        keyLengths[i] = (uint32_t)sprintf(keys[i], "key_%u", i * 2654435761u);
+        //  Start half full so adds and removes both succeed
+        if (i & 1) continue;
+        weu_hashtable_addText(lockedTable, keys[i], keyLengths[i], (void*)(uintptr_t)(i + 1));
+        weu_concurrentHashTable_add(concurrentTable, keys[i], keyLengths[i], (void*)(uintptr_t)(i + 1));
+    }
+
+    printf("threads | global mutex Mops/s | concurrent Mops/s\n");
+    for (uint32_t threadCount = 1; threadCount <= MAX_THREADS; threadCount *= 2) {
+        double locked = run(threadCount, false);
+        double concurrent = run(threadCount, true);
+        printf("%7u | %19.2f | %17.2f\n", threadCount, locked, concurrent);
+    }
+
+    weu_hashtable_free(&lockedTable);
+    weu_concurrentHashTable_free(&concurrentTable);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*  GCC example build command
+
+gcc -Wall -Wextra -Werror -std=c99 -O2 examples/expression_benchmark.c -o a.out
+
+Matches log lines against same expression with weu_string_textMatchesExpression,
+which parses expression while matching, and with expression compiled once by
+weu_expression_compile and matched by weu_expression_match into slices.
+Then joins lines into one text and validates and counts it with weu_charClass
+scanning and with byte by byte lookup, build with -mssse3 or -mavx2 to compare
+vector paths.
+Last classifies lines against PATTERN_COUNT expressions, one by one with
+weu_string_textMatchesExpression, one by one with compiled expressions and
+all at once with weu_expressionSet.
+*/
+
+#define WEU_IMPLEMENTATION
+#include "../include/weu/weu_string.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define LINE_COUNT      500000
+#define PATTERN_COUNT   200
+#define CLASSIFY_COUNT  10000
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    const char *expression = "%s{ }[0-9] %s{ }[A-Z] user_%s{ }[a-z0-9_] %s{ }[!A-Z]";
+    const char *levels[] = {"INFO", "WARN", "ERROR", "debug"};
+    weu_string **lines = (weu_string**)malloc(sizeof(weu_string*) * LINE_COUNT);
+    char buffer[128];
+    for (uint32_t i = 0; i < LINE_COUNT; i++) {
+        sprintf(buffer, "%u %s user_%u request_handled_in_%ums", i * 2654435761u, levels[i % 4], i % 977, i % 300);
+        lines[i] = weu_string_new(buffer);
+    }
+
+    clock_t start = clock();
+    uint32_t textMatches = 0;
+    for (uint32_t i = 0; i < LINE_COUNT; i++) {
+        textMatches += weu_string_textMatchesExpression(lines[i]->text, expression, NULL, NULL);
+    }
+    double textTime = secondsSince(start);
+
+    start = clock();
+    weu_expression *compiled = weu_expression_compile(expression);
+    weu_string *captures = (weu_string*)malloc(sizeof(weu_string) * compiled->varyingCount);
+    uint32_t compiledMatches = 0;
+    uint64_t captureBytes = 0;
+    for (uint32_t i = 0; i < LINE_COUNT; i++) {
+        compiledMatches += weu_expression_match(compiled, lines[i]->text, lines[i]->length, captures, NULL);
+        captureBytes += captures[2].length;
+    }
+    double compiledTime = secondsSince(start);
+    free(captures);
+    weu_expression_free(&compiled);
+
+    printf("textMatchesExpression %7.1f ns | compiled match %6.1f ns | matches %u %u | capture bytes %lu\n",
+        textTime * 1e9 / LINE_COUNT, compiledTime * 1e9 / LINE_COUNT, textMatches, compiledMatches, (unsigned long)captureBytes);
+
+    weu_string *joined = weu_string_new("");
+    for (uint32_t i = 0; i < LINE_COUNT; i++) {
+        weu_string_append(joined, lines[i]->text, lines[i]->length);
+        weu_string_appendChar(joined, ' ');
+    }
+    weu_charClass printable = weu_charClass_new("[ -~]");
+    weu_charClass digits = weu_charClass_new("[0-9]");
+    const uint32_t rounds = 10;
+    start = clock();
+    uint32_t valid = 0, digitCount = 0;
+    for (uint32_t r = 0; r < rounds; r++) {
+        valid += weu_charClass_all(&printable, joined->text, joined->length);
+        digitCount += weu_charClass_count(&digits, joined->text, joined->length);
+    }
+    double scanTime = secondsSince(start);
+    start = clock();
+    uint32_t loopValid = 0, loopDigitCount = 0;
+    for (uint32_t r = 0; r < rounds; r++) {
+        bool all = true;
+        for (uint32_t i = 0; i < joined->length; i++) all &= weu_charClass_contains(&printable, (uint8_t)joined->text[i]);
+        loopValid += all;
+        for (uint32_t i = 0; i < joined->length; i++) loopDigitCount += weu_charClass_contains(&digits, (uint8_t)joined->text[i]);
+    }
+    double loopTime = secondsSince(start);
+    double scannedBytes = 2.0 * rounds * joined->length;
+    printf("class scan %6.2f GB/s | byte lookup %6.2f GB/s | valid %u %u | digits %u %u\n",
+        scannedBytes / scanTime * 1e-9, scannedBytes / loopTime * 1e-9, valid, loopValid, digitCount, loopDigitCount);
+    weu_string_free(&joined);
+
+    char patternTexts[PATTERN_COUNT][80];
+    const char *patterns[PATTERN_COUNT];
+    for (uint32_t k = 0; k < PATTERN_COUNT; k++) {
+        sprintf(patternTexts[k], "%%s{ }[0-9] %s user_%%s{ }[0-9] topic%u_%%s{ }[a-z] %%s[0-9]", levels[k % 4], k);
+        patterns[k] = patternTexts[k];
+    }
+    weu_string **events = (weu_string**)malloc(sizeof(weu_string*) * CLASSIFY_COUNT);
+    for (uint32_t i = 0; i < CLASSIFY_COUNT; i++) {
+        sprintf(buffer, "%u %s user_%u topic%u_%s %u", i * 2654435761u, levels[i % 4], i % 977, (i * 7) % 250, i % 3 ? "sent" : "dropped", i % 300);
+        events[i] = weu_string_new(buffer);
+    }
+    start = clock();
+    uint32_t textClassified = 0;
+    for (uint32_t i = 0; i < CLASSIFY_COUNT; i++) {
+        for (uint32_t k = 0; k < PATTERN_COUNT; k++) textClassified += weu_string_textMatchesExpression(events[i]->text, patterns[k], NULL, NULL);
+    }
+    double textClassifyTime = secondsSince(start);
+
+    weu_expression *compiledPatterns[PATTERN_COUNT];
+    for (uint32_t k = 0; k < PATTERN_COUNT; k++) compiledPatterns[k] = weu_expression_compile(patterns[k]);
+    start = clock();
+    uint32_t compiledClassified = 0;
+    for (uint32_t i = 0; i < CLASSIFY_COUNT; i++) {
+        for (uint32_t k = 0; k < PATTERN_COUNT; k++) compiledClassified += weu_expression_match(compiledPatterns[k], events[i]->text, events[i]->length, NULL, NULL);
+    }
+    double compiledClassifyTime = secondsSince(start);
+    for (uint32_t k = 0; k < PATTERN_COUNT; k++) weu_expression_free(&compiledPatterns[k]);
+
+    weu_expressionSet *set = weu_expressionSet_new(patterns, PATTERN_COUNT);
+    weu_string *setCaptures = (weu_string*)malloc(sizeof(weu_string) * set->captureCount);
+    uint32_t ids[PATTERN_COUNT];
+    start = clock();
+    uint32_t setClassified = 0;
+    for (uint32_t i = 0; i < CLASSIFY_COUNT; i++) {
+        setClassified += weu_expressionSet_match(set, events[i]->text, events[i]->length, ids, setCaptures);
+    }
+    double setClassifyTime = secondsSince(start);
+    printf("%u patterns | textMatchesExpression %8.1f us | compiled %6.1f us | expression set %5.2f us per line | matches %u %u %u\n", PATTERN_COUNT,
+        textClassifyTime * 1e6 / CLASSIFY_COUNT, compiledClassifyTime * 1e6 / CLASSIFY_COUNT, setClassifyTime * 1e6 / CLASSIFY_COUNT,
+        textClassified, compiledClassified, setClassified);
+    free(setCaptures);
+    weu_expressionSet_free(&set);
+    for (uint32_t i = 0; i < CLASSIFY_COUNT; i++) weu_string_free(&events[i]);
+    free(events);
+    for (uint32_t i = 0; i < LINE_COUNT; i++) weu_string_free(&lines[i]);
+    free(lines);
+    return 0;
+}
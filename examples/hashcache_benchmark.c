@@ -0,0 +1,52 @@
+/*  GCC example build command
+
+gcc -Wall -Wextra -Werror -std=c99 -O2 examples/hashcache_benchmark.c -o a.out
+
+Skewed key stream (80% of requests go to 10% of keys) through cache holding 5% of keys.
+Reports hit rate and cost of get followed by put on miss, with entry and byte budgets.
+*/
+
+#define WEU_IMPLEMENTATION
+#include "../include/weu/weu_hashcache.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define KEY_COUNT       (1 << 20)
+#define REQUEST_COUNT   10000000
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+static inline uint64_t nextRandom(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void benchmark(const char *name, const weu_hashCacheDesc *desc) {
+    weu_hashCache *cache = weu_hashCache_new(desc);
+    uint64_t rng = 0x9e3779b97f4a7c15ULL, hits = 0;
+    char key[32];
+    clock_t start = clock();
+    for (uint32_t i = 0; i < REQUEST_COUNT; i++) {
+        uint64_t r = nextRandom(&rng);
+        uint32_t k = (uint32_t)(r >> 12) % (r % 10 < 8 ? KEY_COUNT / 10 : KEY_COUNT);
+        uint32_t length = (uint32_t)sprintf(key, "/srv/cache/%u", k * 2654435761u);
+        if (weu_hashCache_get(cache, key, length, NULL) == WEU_HASH_OK) hits++;
+        else weu_hashCache_put(cache, key, length, (void*)(uintptr_t)(k + 1), 64 + k % 256);
+    }
+    double time = secondsSince(start);
+    printf("%-14s hit rate %5.1f%% | request %6.1f ns | count %u | bytes %llu | evictions %llu\n", name,
+        100.0 * hits / REQUEST_COUNT, time * 1e9 / REQUEST_COUNT, weu_hashCache_count(cache),
+        (unsigned long long)weu_hashCache_bytes(cache), (unsigned long long)weu_hashCache_evictions(cache));
+    weu_hashCache_free(&cache);
+}
+
+int main() {
+    benchmark("entry budget", &(weu_hashCacheDesc){.maxEntries = KEY_COUNT / 20});
+    benchmark("byte budget", &(weu_hashCacheDesc){.maxBytes = (uint64_t)KEY_COUNT / 20 * 220});
+    benchmark("GROUP entries", &(weu_hashCacheDesc){.table = {.engine = WEU_HASHENGINE_GROUP}, .maxEntries = KEY_COUNT / 20});
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*  GCC example build command
+
+gcc -Wall -Wextra -Werror -std=c99 -O2 examples/hashtable_benchmark.c -o a.out
+
+Compares WEU_HASHENGINE_LINEAR and WEU_HASHENGINE_GROUP engines.
+Item count is chosen so GROUP table ends up close to its maximum load.
+Also compares WEU_HASHKEY_INT64 keys with formatting ids to text keys
+and batched weu_hashtable_getValues with one at a time lookups.
+Iteration walks dense entries after every other item was removed,
+remaining items are then frozen and looked up through minimal perfect hash.
+First freezes small table of every weu_hashFunction and of CUSTOM key
+mode with 32 bit hasher, and checks every key is found after freezing.
+*/
+
+#define WEU_IMPLEMENTATION
+#include "../include/weu/weu_hashtable.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ITEM_COUNT  1824000
+#define LOOKUP_REPEAT 4
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+#define FREEZE_CHECK_COUNT 50000
+
+static uint64_t hash32(const void *key, uint32_t length, uint64_t seed) {
+    return (uint32_t)weu_hash_wy(key, length, seed);
+}
+static bool keyEqual(const void *a, const void *b, uint32_t length) {
+    return memcmp(a, b, length) == 0;
+}
+static void checkFreeze(const char *name, weu_hashTableDesc desc) {
+    char buffer[64];
+    weu_hashTable *table = weu_hashtable_newDesc(&desc);
+    for (uint32_t i = 0; i < FREEZE_CHECK_COUNT; i++) {
+        int length = sprintf(buffer, "/srv/data/item_%u.bin", i * 2654435761u);
+        weu_hashtable_addText(table, buffer, (uint32_t)length, (void*)(uintptr_t)(i + 1));
+    }
+    weu_frozenHashTable *frozen = weu_hashtable_freeze(&table);
+    uint32_t found = 0;
+    for (uint32_t i = 0; frozen != NULL && i < FREEZE_CHECK_COUNT; i++) {
+        int length = sprintf(buffer, "/srv/data/item_%u.bin", i * 2654435761u);
+        void *value;
+        found += weu_frozenHashTable_getText(frozen, buffer, (uint32_t)length, &value) == WEU_HASH_OK && (uintptr_t)value == i + 1;
+    }
+    bool missing = frozen != NULL && weu_frozenHashTable_getText(frozen, "/srv/data/missing", 17, NULL) == WEU_HASH_NOT_FOUND;
+    printf("freeze %-10s %s | found %u / %u\n", name, frozen != NULL && found == FREEZE_CHECK_COUNT && missing ? "ok" : "FAILED", found, FREEZE_CHECK_COUNT);
+    weu_frozenHashTable_free(&frozen);
+    weu_hashtable_free(&table);
+}
+
+static void benchmark(const char *name, weu_hashEngine engine, weu_string **keys, weu_string **missingKeys) {
+    clock_t start = clock();
+    weu_hashTable *table = weu_hashtable_newDesc(&(weu_hashTableDesc){.engine = engine});
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+        weu_hashtable_addItem(table, keys[i], (void*)(uintptr_t)(i + 1), false);
+    }
+    double insertTime = secondsSince(start);
+
+    start = clock();
+    uintptr_t checksum = 0;
+    for (uint32_t r = 0; r < LOOKUP_REPEAT; r++) {
+        for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+            checksum += (uintptr_t)weu_hashtable_getValue(table, keys[i], false);
+        }
+    }
+    double hitTime = secondsSince(start);
+
+    weu_string *slices = (weu_string*)malloc(sizeof(weu_string) * ITEM_COUNT);
+    void **values = (void**)malloc(sizeof(void*) * ITEM_COUNT);
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) slices[i] = *keys[i];
+    start = clock();
+    for (uint32_t r = 0; r < LOOKUP_REPEAT; r++) {
+        weu_hashtable_getValues(table, slices, ITEM_COUNT, values);
+        for (uint32_t i = 0; i < ITEM_COUNT; i++) checksum += (uintptr_t)values[i];
+    }
+    double batchTime = secondsSince(start);
+    free(slices);
+    free(values);
+
+    start = clock();
+    uint32_t missCount = 0;
+    for (uint32_t r = 0; r < LOOKUP_REPEAT; r++) {
+        for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+            missCount += weu_hashtable_getText(table, missingKeys[i]->text, missingKeys[i]->length, NULL) == WEU_HASH_NOT_FOUND;
+        }
+    }
+    double missTime = secondsSince(start);
+    double load = 100.0 * table->count / table->length;
+
+    for (uint32_t i = 0; i < ITEM_COUNT; i += 2) weu_hashtable_removeSlice(table, *keys[i]);
+    start = clock();
+    for (uint32_t r = 0; r < LOOKUP_REPEAT; r++) {
+        uint32_t iterator = 0;
+        void *value;
+        while (weu_hashtable_next(table, &iterator, NULL, &value)) checksum += (uintptr_t)value;
+    }
+    double iterateTime = secondsSince(start);
+
+    uint32_t liveCount = table->count;
+    weu_frozenHashTable *frozen = weu_hashtable_freeze(&table);
+    start = clock();
+    for (uint32_t r = 0; r < LOOKUP_REPEAT; r++) {
+        for (uint32_t i = 1; i < ITEM_COUNT; i += 2) {
+            void *value;
+            weu_frozenHashTable_getSlice(frozen, *keys[i], &value);
+            checksum += (uintptr_t)value;
+        }
+    }
+    double frozenTime = secondsSince(start);
+    weu_frozenHashTable_free(&frozen);
+
+    printf("%-7s load %5.1f%% | insert %7.1f ns | hit %7.1f ns | batch hit %7.1f ns | miss %7.1f ns | iterate %5.1f ns | frozen hit %5.1f ns | checksum %lu %u\n", name,
+        load,
+        insertTime * 1e9 / ITEM_COUNT,
+        hitTime * 1e9 / ((double)ITEM_COUNT * LOOKUP_REPEAT),
+        batchTime * 1e9 / ((double)ITEM_COUNT * LOOKUP_REPEAT),
+        missTime * 1e9 / ((double)ITEM_COUNT * LOOKUP_REPEAT),
+        iterateTime * 1e9 / ((double)liveCount * LOOKUP_REPEAT),
+        frozenTime * 1e9 / ((double)liveCount * LOOKUP_REPEAT),
+        (unsigned long)checksum, missCount);
+}
+
+static void benchmarkInt(weu_hashEngine engine) {
+    char buffer[32];
+    clock_t start = clock();
+    weu_hashTable *table = weu_hashtable_newDesc(&(weu_hashTableDesc){.engine = engine});
+    uintptr_t checksum = 0;
+    for (uint64_t i = 0; i < ITEM_COUNT; i++) {
+        int length = sprintf(buffer, "%llu", (unsigned long long)(i * 2654435761u));
+        weu_hashtable_addText(table, buffer, (uint32_t)length, (void*)(uintptr_t)(i + 1));
+    }
+    for (uint64_t i = 0; i < ITEM_COUNT; i++) {
+        void *value;
+        int length = sprintf(buffer, "%llu", (unsigned long long)(i * 2654435761u));
+        weu_hashtable_getText(table, buffer, (uint32_t)length, &value);
+        checksum += (uintptr_t)value;
+    }
+    double textTime = secondsSince(start);
+    weu_hashtable_free(&table);
+
+    start = clock();
+    table = weu_hashtable_newDesc(&(weu_hashTableDesc){.engine = engine, .keyMode = WEU_HASHKEY_INT64});
+    for (uint64_t i = 0; i < ITEM_COUNT; i++) {
+        weu_hashtable_addInt(table, i * 2654435761u, (void*)(uintptr_t)(i + 1));
+    }
+    for (uint64_t i = 0; i < ITEM_COUNT; i++) {
+        void *value;
+        weu_hashtable_getInt(table, i * 2654435761u, &value);
+        checksum += (uintptr_t)value;
+    }
+    double intTime = secondsSince(start);
+    weu_hashtable_free(&table);
+
+    printf("%-7s id as text %7.1f ns | id as int %7.1f ns | checksum %lu\n", engine == WEU_HASHENGINE_GROUP ? "GROUP" : "LINEAR",
+        textTime * 1e9 / ((double)ITEM_COUNT * 2),
+        intTime * 1e9 / ((double)ITEM_COUNT * 2),
+        (unsigned long)checksum);
+}
+
+int main() {
+    checkFreeze("WY", (weu_hashTableDesc){.hash = WEU_HASHFUN_WY});
+    checkFreeze("CRC32C", (weu_hashTableDesc){.hash = WEU_HASHFUN_CRC32C});
+    checkFreeze("FNV", (weu_hashTableDesc){.hash = WEU_HASHFUN_FNV});
+    checkFreeze("CUSTOM 32", (weu_hashTableDesc){.keyMode = WEU_HASHKEY_CUSTOM, .keyHash = hash32, .keyCompare = keyEqual});
+
+    weu_string **keys        = (weu_string**)malloc(sizeof(weu_string*) * ITEM_COUNT);
+    weu_string **missingKeys = (weu_string**)malloc(sizeof(weu_string*) * ITEM_COUNT);
+    char buffer[64];
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+        sprintf(buffer, "/srv/data/item_%u.bin", i * 2654435761u);
+        keys[i] = weu_string_new(buffer);
+        sprintf(buffer, "/srv/data/item_%u.tmp", i * 2654435761u);
+        missingKeys[i] = weu_string_new(buffer);
+    }
+
+    benchmark("LINEAR", WEU_HASHENGINE_LINEAR, keys, missingKeys);
+    benchmark("GROUP", WEU_HASHENGINE_GROUP, keys, missingKeys);
+    benchmarkInt(WEU_HASHENGINE_LINEAR);
+    benchmarkInt(WEU_HASHENGINE_GROUP);
+
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+        weu_string_free(&keys[i]);
+        weu_string_free(&missingKeys[i]);
+    }
+    free(keys);
+    free(missingKeys);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*  GCC example build command
+
+gcc -Wall -Wextra -Werror -std=c99 -O2 examples/hashtable_snapshot_benchmark.c -o a.out
+
+Compares startup of table rebuilt from text file with weu_io_loadText and
+table opened in place from snapshot written by weu_io_writeHashtable.
+First writes and maps snapshot of smaller WEU_HASHFUN_FNV table and checks
+every key is found in it.
+*/
+
+#define WEU_IMPLEMENTATION
+#include "../include/weu/weu_master.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ITEM_COUNT          1000000
+#define SNAP_CHECK_COUNT    100000
+#define TEXT_PATH   "hashtable_snapshot_benchmark.txt"
+#define SNAP_PATH   "hashtable_snapshot_benchmark.snap"
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+static void valueFree(void **value) {
+    free(*value);
+}
+static uint32_t valueSize(const void *value) {
+    return (uint32_t)strlen((const char*)value) + 1;
+}
+
+static void checkFNVSnapshot(void) {
+    char key[64];
+    weu_hashTable *table = weu_hashtable_newDesc(&(weu_hashTableDesc){.hash = WEU_HASHFUN_FNV});
+    for (uint32_t i = 0; i < SNAP_CHECK_COUNT; i++) {
+        uint32_t length = (uint32_t)sprintf(key, "/srv/data/item_%u.bin", i * 2654435761u);
+        weu_hashtable_addText(table, key, length, (void*)(uintptr_t)(i + 1));
+    }
+    bool written = weu_io_writeHashtable(SNAP_PATH, table, NULL);
+    weu_hashtable_free(&table);
+    weu_hashSnapshot *snapshot = written ? weu_io_mapHashtable(SNAP_PATH) : NULL;
+    uint32_t found = 0;
+    for (uint32_t i = 0; snapshot != NULL && i < SNAP_CHECK_COUNT; i++) {
+        uint32_t length = (uint32_t)sprintf(key, "/srv/data/item_%u.bin", i * 2654435761u);
+        const void *value;
+        found += weu_hashSnapshot_getText(snapshot, key, length, &value, NULL) == WEU_HASH_OK && (uintptr_t)value == i + 1;
+    }
+    printf("FNV snapshot %s | found %u / %u\n", found == SNAP_CHECK_COUNT ? "ok" : "FAILED", found, SNAP_CHECK_COUNT);
+    weu_io_unmapHashtable(&snapshot);
+    remove(SNAP_PATH);
+}
+
+int main() {
+    checkFNVSnapshot();
+
+    FILE *file = fopen(TEXT_PATH, "w");
+    if (file == NULL) return 1;
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) fprintf(file, "/srv/data/item_%u.bin %u\n", i * 2654435761u, i);
+    fclose(file);
+
+    //  Text startup, parse every line and insert key with copy of value
+    clock_t start = clock();
+    weu_string *text = weu_io_loadText(TEXT_PATH);
+    weu_hashTable *table = weu_hashtable_new(0, valueFree);
+    for (uint32_t line = 0, i = 0; i < text->length; line = ++i) {
+        while (text->text[i] != ' ') i++;
+        uint32_t space = i;
+        while (text->text[i] != '\n') i++;
+        char *value = (char*)malloc(i - space);
+        memcpy(value, text->text + space + 1, i - space - 1);
+        value[i - space - 1] = '\0';
+        weu_hashtable_addText(table, text->text + line, space - line, value);
+    }
+    double textTime = secondsSince(start);
+    weu_string_free(&text);
+
+    start = clock();
+    bool written = weu_io_writeHashtable(SNAP_PATH, table, valueSize);
+    double writeTime = secondsSince(start);
+    weu_hashtable_free(&table);
+    if (!written) return 1;
+
+    //  Snapshot startup, map file and query in place
+    start = clock();
+    weu_hashSnapshot *snapshot = weu_io_mapHashtable(SNAP_PATH);
+    double mapTime = secondsSince(start);
+    if (snapshot == NULL) return 1;
+
+    char key[64];
+    uint32_t found = 0;
+    start = clock();
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+        uint32_t length = (uint32_t)sprintf(key, "/srv/data/item_%u.bin", i * 2654435761u);
+        const void *value;
+        found += weu_hashSnapshot_getText(snapshot, key, length, &value, NULL) == WEU_HASH_OK && (uint32_t)atoi((const char*)value) == i;
+    }
+    double lookupTime = secondsSince(start);
+
+    printf("text load %.3f s | snapshot write %.3f s | snapshot map %.6f s | lookup %.1f ns | found %u\n",
+        textTime, writeTime, mapTime, lookupTime * 1e9 / ITEM_COUNT, found);
+    weu_io_unmapHashtable(&snapshot);
+    remove(TEXT_PATH);
+    remove(SNAP_PATH);
+    return 0;
+}
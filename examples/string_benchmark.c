@@ -0,0 +1,139 @@
+/*  GCC example build command
+
+gcc -Wall -Wextra -Werror -std=c99 -O2 examples/string_benchmark.c -o a.out
+
+Builds report of about 10 MB from short lines, once with weu_string_concateText,
+once with weu_string_append into reserved string and once with weu_stringBuilder
+joined into single weu_string at the end.
+Then searches report for needles of several lengths with weu_stringNeedle_find
+and strstr and counts matches, and splits it into lines with weu_string_splitByChar
+and with allocation free weu_stringTokenizer, and reads its lines one by one with
+weu_string_getLine and with weu_stringLineIterator.
+Last formats numbers with sprintf and with weu_charconv, and appends them
+to single string with weu_string_appendUInt and weu_string_appendDouble.
+*/
+
+#define WEU_IMPLEMENTATION
+#include "../include/weu/weu_stringbuilder.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define LINE_COUNT  400000
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    char line[64];
+
+    clock_t start = clock();
+    weu_string *report = weu_string_new("");
+    for (uint32_t i = 0; i < LINE_COUNT; i++) {
+        sprintf(line, "%u", i * 2654435761u);
+        weu_string_concateText(report, 3, "row ", line, " | status ok\n");
+    }
+    double concateTime = secondsSince(start);
+    uint32_t concateLength = report->length;
+    weu_string_free(&report);
+
+    start = clock();
+    report = weu_string_new("");
+    weu_string_reserve(report, concateLength);
+    for (uint32_t i = 0; i < LINE_COUNT; i++) {
+        uint32_t length = (uint32_t)sprintf(line, "%u", i * 2654435761u);
+        weu_string_append(report, "row ", 4);
+        weu_string_append(report, line, length);
+        weu_string_append(report, " | status ok\n", 13);
+    }
+    double appendTime = secondsSince(start);
+
+    weu_string_free(&report);
+
+    start = clock();
+    weu_stringBuilder *builder = weu_stringBuilder_new(0);
+    for (uint32_t i = 0; i < LINE_COUNT; i++) {
+        weu_stringBuilder_append(builder, "row ", 4);
+        weu_stringBuilder_appendUInt(builder, i * 2654435761u);
+        weu_stringBuilder_append(builder, " | status ok\n", 13);
+    }
+    report = weu_stringBuilder_toString(builder);
+    double builderTime = secondsSince(start);
+    weu_stringBuilder_free(&builder);
+
+    printf("report %u bytes | concateText %.3f s | reserve + append %.3f s | builder %.3f s\n", report->length, concateTime, appendTime, builderTime);
+
+    const char *needles[] = {"ok\nrow 1", "status ok\nrow 42", "| status ok\nrow 3999999999 | status ok\nrow 1234567890 | status ok\nrow 77"};
+    for (uint32_t n = 0; n < sizeof(needles) / sizeof(needles[0]); n++) {
+        weu_stringNeedle *needle = weu_stringNeedle_new(needles[n], (uint32_t)strlen(needles[n]));
+        uint32_t found = 0, libcFound = 0;
+        start = clock();
+        for (uint32_t pos = 0; (pos = weu_stringNeedle_find(needle, report->text, report->length, pos)) != WEU_INDEX_INVALID; pos++) found++;
+        double findTime = secondsSince(start);
+        start = clock();
+        for (const char *p = report->text; (p = strstr(p, needles[n])) != NULL; p++) libcFound++;
+        double strstrTime = secondsSince(start);
+        printf("needle %3u bytes | find %6.2f GB/s | strstr %6.2f GB/s | matches %u %u\n", needle->length,
+            report->length / findTime * 1e-9, report->length / strstrTime * 1e-9, found, libcFound);
+        weu_stringNeedle_free(&needle);
+    }
+
+    start = clock();
+    weu_list *lines = weu_string_splitByChar(report, '\n');
+    uint32_t splitCount = lines->count;
+    weu_list_free(&lines, true);
+    double splitTime = secondsSince(start);
+    start = clock();
+    uint32_t tokenCount = 0;
+    weu_stringTokenizer tokenizer = weu_stringTokenizer_new(report->text, report->length, '\n');
+    weu_string token;
+    while (weu_stringTokenizer_next(&tokenizer, &token)) tokenCount += token.length > 0;
+    double tokenTime = secondsSince(start);
+    start = clock();
+    uint32_t getLineCount = 0;
+    report->charPtrPos = 0;
+    while (report->charPtrPos < report->length) {
+        weu_string *line = weu_string_getLine(report);
+        getLineCount += line->length > 0;
+        weu_string_free(&line);
+    }
+    double getLineTime = secondsSince(start);
+    start = clock();
+    uint32_t iteratorCount = 0;
+    weu_stringLineIterator lineIterator = weu_string_lines(report, true);
+    while (weu_stringLineIterator_next(&lineIterator, &token)) iteratorCount += token.length > 0;
+    double iteratorTime = secondsSince(start);
+    printf("lines %u %u %u %u | splitByChar %.3f s | tokenizer %.3f s | getLine %.3f s | line iterator %.3f s\n",
+        splitCount, tokenCount, getLineCount, iteratorCount, splitTime, tokenTime, getLineTime, iteratorTime);
+    weu_string_free(&report);
+
+    uint64_t checksum = 0;
+    start = clock();
+    for (uint32_t i = 0; i < LINE_COUNT * 10; i++) checksum += (uint32_t)sprintf(line, "%llu", (unsigned long long)i * 2654435761u);
+    double sprintfIntTime = secondsSince(start);
+    start = clock();
+    for (uint32_t i = 0; i < LINE_COUNT * 10; i++) checksum += weu_charconv_formatUInt(line, (uint64_t)i * 2654435761u);
+    double formatIntTime = secondsSince(start);
+    start = clock();
+    for (uint32_t i = 0; i < LINE_COUNT; i++) checksum += (uint32_t)sprintf(line, "%.17g", i * 0.731);
+    double sprintfDoubleTime = secondsSince(start);
+    start = clock();
+    for (uint32_t i = 0; i < LINE_COUNT; i++) checksum += weu_charconv_formatDouble(line, i * 0.731);
+    double formatDoubleTime = secondsSince(start);
+    start = clock();
+    weu_string *numbers = weu_string_new("");
+    for (uint32_t i = 0; i < LINE_COUNT; i++) {
+        weu_string_appendUInt(numbers, (uint64_t)i * 2654435761u);
+        weu_string_appendChar(numbers, ' ');
+        weu_string_appendDouble(numbers, i * 0.731);
+        weu_string_appendChar(numbers, '\n');
+    }
+    double appendNumberTime = secondsSince(start);
+    printf("uint sprintf %.1f ns | formatUInt %.1f ns | double sprintf %.1f ns | formatDouble %.1f ns | append numbers %.3f s | checksum %lu %u\n",
+        sprintfIntTime * 1e9 / (LINE_COUNT * 10), formatIntTime * 1e9 / (LINE_COUNT * 10),
+        sprintfDoubleTime * 1e9 / LINE_COUNT, formatDoubleTime * 1e9 / LINE_COUNT, appendNumberTime,
+        (unsigned long)checksum, numbers->length);
+    weu_string_free(&numbers);
+    return 0;
+}
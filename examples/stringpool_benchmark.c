@@ -0,0 +1,69 @@
+/*  GCC example build command
+
+gcc -Wall -Wextra -Werror -std=c99 -O2 examples/stringpool_benchmark.c -o a.out
+
+Parses records made of repeating field names, keeps field name of every record
+once as weu_string copy and once as symbol of weu_stringPool.
+Compares memory kept and cost of comparing field names of all record pairs.
+*/
+
+#define WEU_IMPLEMENTATION
+#include "../include/weu/weu_stringpool.h"
+#include "../include/weu/weu_string.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define RECORD_COUNT    1000000
+#define FIELD_COUNT     200
+#define COMPARE_COUNT   20000000
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    weu_string **copies = (weu_string**)malloc(sizeof(weu_string*) * RECORD_COUNT);
+    const weu_string **interned = (const weu_string**)malloc(sizeof(weu_string*) * RECORD_COUNT);
+    weu_stringPool *pool = weu_stringPool_new(FIELD_COUNT);
+    char field[64];
+    uint64_t copyBytes = 0;
+
+    clock_t start = clock();
+    for (uint32_t i = 0; i < RECORD_COUNT; i++) {
+        sprintf(field, "customer_record_field_%u", (i * 2654435761u) % FIELD_COUNT);
+        copies[i] = weu_string_new(field);
+        copyBytes += sizeof(weu_string) + copies[i]->length + 1;
+    }
+    double copyTime = secondsSince(start);
+
+    start = clock();
+    for (uint32_t i = 0; i < RECORD_COUNT; i++) {
+        uint32_t length = (uint32_t)sprintf(field, "customer_record_field_%u", (i * 2654435761u) % FIELD_COUNT);
+        interned[i] = weu_stringPool_internString(pool, field, length);
+    }
+    double internTime = secondsSince(start);
+
+    uint32_t copyMatches = 0, internMatches = 0;
+    start = clock();
+    for (uint32_t i = 0; i < COMPARE_COUNT; i++) {
+        copyMatches += weu_string_matches(copies[i % RECORD_COUNT], copies[(i * 7919u) % RECORD_COUNT]);
+    }
+    double copyCompare = secondsSince(start);
+    start = clock();
+    for (uint32_t i = 0; i < COMPARE_COUNT; i++) {
+        internMatches += interned[i % RECORD_COUNT] == interned[(i * 7919u) % RECORD_COUNT];
+    }
+    double internCompare = secondsSince(start);
+
+    printf("copies   build %.3f s | %10llu bytes | compare %5.2f ns | matches %u\n", copyTime,
+        (unsigned long long)copyBytes, copyCompare * 1e9 / COMPARE_COUNT, copyMatches);
+    printf("interned build %.3f s | %10llu bytes | compare %5.2f ns | matches %u\n", internTime,
+        (unsigned long long)(pool->bytes + (uint64_t)pool->count * sizeof(weu_string)), internCompare * 1e9 / COMPARE_COUNT, internMatches);
+
+    for (uint32_t i = 0; i < RECORD_COUNT; i++) weu_string_free(&copies[i]);
+    free(copies);
+    free(interned);
+    weu_stringPool_free(&pool);
+    return 0;
+}
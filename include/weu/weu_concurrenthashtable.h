@@ -0,0 +1,409 @@
+/*///////////////////////////////////////////////////////////////////////////////////
+//  SPDX-License-Identifier: Unlicense
+/////////////////////////////////////////////////////////////////////////////////////
+//  USAGE
+//  Functions are defined as extern.
+//  To implement somewhere in source file before including header file
+//  #define WEU_IMPLEMENTATION
+//  Implementation should be defined once.
+//
+//  #define WEU_IMPLEMENTATION
+//  #include <path_to_lib/weu_concurrenthashtable.h>
+//
+//  Requires POSIX threads and GCC/Clang __atomic builtins, link with -pthread.
+//  Not included by weu_master.h.
+*////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef weu_concurrenthashtable_h
+#define weu_concurrenthashtable_h
+
+#define WEUDEF extern
+
+#include "weu_hashtable.h"
+
+//  Hashtable shared between threads.
+//  Keys are split to shards by hash bits, each shard has its own writer lock.
+//  Readers take no locks, removed keys and values are reclaimed with epoch based reclamation,
+//  datafreefun runs only after every reader that could see removed value has left.
+typedef struct weu_concurrentHashTable {} weu_concurrentHashTable;
+
+//  Shard count is rounded up to power of two, 0 uses WEU_CONCURRENT_DEFAULT_SHARDS.
+WEUDEF weu_concurrentHashTable *weu_concurrentHashTable_new(uint32_t shardCount, datafreefun d);
+//  Table must not be used by other threads while freeing.
+WEUDEF void weu_concurrentHashTable_free(weu_concurrentHashTable **handle);
+
+//  Value returned by get stays valid until readEnd when called between readBegin and readEnd,
+//  otherwise only until value is removed or replaced by other thread.
+WEUDEF weu_hashStatus weu_concurrentHashTable_get(weu_concurrentHashTable *table, const char *key, uint32_t keyLen, void **valueOut);
+//  Returns WEU_HASH_EXISTS if key is present, value is not added.
+WEUDEF weu_hashStatus weu_concurrentHashTable_add(weu_concurrentHashTable *table, const char *key, uint32_t keyLen, void *value);
+//  Adds key or replaces value of present key, replaced value is freed with datafreefun once safe.
+WEUDEF weu_hashStatus weu_concurrentHashTable_set(weu_concurrentHashTable *table, const char *key, uint32_t keyLen, void *value);
+WEUDEF weu_hashStatus weu_concurrentHashTable_remove(weu_concurrentHashTable *table, const char *key, uint32_t keyLen);
+
+//  Keeps values returned by get alive until readEnd, calls can be nested.
+//  Returns false if no reader record is free, get then falls back to shard lock.
+WEUDEF bool weu_concurrentHashTable_readBegin(weu_concurrentHashTable *table);
+WEUDEF void weu_concurrentHashTable_readEnd(weu_concurrentHashTable *table);
+
+WEUDEF uint32_t weu_concurrentHashTable_count(weu_concurrentHashTable *table);
+
+#ifdef WEU_IMPLEMENTATION
+
+#include <pthread.h>
+
+//  Reader records are shared by all concurrent tables, one per thread while thread lives.
+#ifndef WEU_CONCURRENT_MAX_THREADS
+#define WEU_CONCURRENT_MAX_THREADS      256
+#endif
+#ifndef WEU_CONCURRENT_DEFAULT_SHARDS
+#define WEU_CONCURRENT_DEFAULT_SHARDS   64
+#endif
+#define WEU_CONCURRENT_MAX_LOAD         75
+//  Retired objects collected by shard before it tries to advance epoch.
+#define WEU_CONCURRENT_RECLAIM_BATCH    64
+#define WEU_CONCURRENT_CACHE_LINE       64
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  EPOCH
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//  epoch - (observed global epoch << 1) | 1 while inside read section, 0 outside
+typedef struct _weu_epochRecord {
+    uint64_t epoch;
+    uint32_t used, depth;
+    char pad[WEU_CONCURRENT_CACHE_LINE - 16];
+} _weu_epochRecord;
+
+static struct {
+    uint64_t epoch;
+    char pad[WEU_CONCURRENT_CACHE_LINE - 8];
+    _weu_epochRecord records[WEU_CONCURRENT_MAX_THREADS];
+    pthread_key_t key;
+    pthread_once_t once;
+} _weu_epoch = { .epoch = 1, .once = PTHREAD_ONCE_INIT };
+
+static void _weu_epoch_releaseRecord(void *data) {
+    _weu_epochRecord *record = (_weu_epochRecord*)data;
+    record->depth = 0;
+    __atomic_store_n(&record->epoch, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&record->used, 0, __ATOMIC_RELEASE);
+}
+static void _weu_epoch_init(void) {
+    pthread_key_create(&_weu_epoch.key, _weu_epoch_releaseRecord);
+}
+//  Returns record of calling thread, claims free one on first use. NULL if all are taken.
+static _weu_epochRecord *_weu_epoch_record(void) {
+    pthread_once(&_weu_epoch.once, _weu_epoch_init);
+    _weu_epochRecord *record = (_weu_epochRecord*)pthread_getspecific(_weu_epoch.key);
+    if (record != NULL) return record;
+    for (uint32_t i = 0; i < WEU_CONCURRENT_MAX_THREADS; i++) {
+        uint32_t expected = 0;
+        if (__atomic_compare_exchange_n(&_weu_epoch.records[i].used, &expected, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            record = &_weu_epoch.records[i];
+            record->depth = 0;
+            pthread_setspecific(_weu_epoch.key, record);
+            return record;
+        }
+    }
+    return NULL;
+}
+static _weu_epochRecord *_weu_epoch_enter(void) {
+    _weu_epochRecord *record = _weu_epoch_record();
+    if (record == NULL) return NULL;
+    if (record->depth++ == 0) {
+        uint64_t epoch = __atomic_load_n(&_weu_epoch.epoch, __ATOMIC_RELAXED);
+        //  Announcement must be visible to writers before any slot is read
+        __atomic_store_n(&record->epoch, (epoch << 1) | 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    }
+    return record;
+}
+static void _weu_epoch_leave(_weu_epochRecord *record) {
+    if (record == NULL || record->depth == 0) return;
+    if (--record->depth == 0) __atomic_store_n(&record->epoch, 0, __ATOMIC_RELEASE);
+}
+//  Advances global epoch if every active reader has observed current one, returns current epoch.
+static uint64_t _weu_epoch_tryAdvance(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint64_t epoch = __atomic_load_n(&_weu_epoch.epoch, __ATOMIC_SEQ_CST);
+    for (uint32_t i = 0; i < WEU_CONCURRENT_MAX_THREADS; i++) {
+        uint64_t observed = __atomic_load_n(&_weu_epoch.records[i].epoch, __ATOMIC_SEQ_CST);
+        if ((observed & 1) && (observed >> 1) != epoch) return epoch;
+    }
+    if (__atomic_compare_exchange_n(&_weu_epoch.epoch, &epoch, epoch + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) return epoch + 1;
+    return epoch;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTERNAL
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//  Keys are immutable once published, freed through reclamation after removal.
+typedef struct _weu_concurrentKey {
+    uint32_t length;
+    char text[];
+} _weu_concurrentKey;
+//  Slot key goes empty -> key -> tombstone and is never reused until shard is resized,
+//  so value read after matching key always belongs to that key.
+typedef struct _weu_concurrentSlot {
+    uint64_t hash;
+    _weu_concurrentKey *key;
+    void *value;
+} _weu_concurrentSlot;
+typedef struct _weu_concurrentArray {
+    uint32_t length;
+    _weu_concurrentSlot slots[];
+} _weu_concurrentArray;
+
+typedef enum _weu_retiredKind { _WEU_RETIRED_MEMORY, _WEU_RETIRED_VALUE } _weu_retiredKind;
+typedef struct _weu_retired {
+    void *data;
+    uint64_t epoch;
+    _weu_retiredKind kind;
+} _weu_retired;
+
+//  used - live keys and tombstones
+typedef struct _weu_concurrentShard {
+    pthread_mutex_t lock;
+    _weu_concurrentArray *data;
+    uint32_t count, used;
+    _weu_retired *retired;
+    uint32_t retiredLength, retiredCapacity;
+} _weu_concurrentShard;
+//  Shards padded to separate cache lines
+typedef union _weu_concurrentShardPadded {
+    _weu_concurrentShard shard;
+    char pad[2 * WEU_CONCURRENT_CACHE_LINE * ((sizeof(_weu_concurrentShard) + 2 * WEU_CONCURRENT_CACHE_LINE - 1) / (2 * WEU_CONCURRENT_CACHE_LINE))];
+} _weu_concurrentShardPadded;
+
+typedef struct _weu_concurrentHashTable {
+    _weu_concurrentShardPadded *shards;
+    uint32_t shardMask;
+    uint64_t seed;
+    datafreefun d;
+} _weu_concurrentHashTable;
+
+static _weu_concurrentKey _weu_concurrent_tombstone;
+#define _WEU_CONCURRENT_TOMBSTONE (&_weu_concurrent_tombstone)
+
+static _weu_concurrentArray *_weu_concurrent_allocArray(uint32_t length) {
+    _weu_concurrentArray *out = (_weu_concurrentArray*)calloc(1, sizeof(_weu_concurrentArray) + sizeof(_weu_concurrentSlot) * length);
+    out->length = length;
+    return out;
+}
+static inline _weu_concurrentShard *_weu_concurrent_shard(const _weu_concurrentHashTable *table, uint64_t hash) {
+    //  Slots use low hash bits, shards high ones
+    return &table->shards[(uint32_t)(hash >> 40) & table->shardMask].shard;
+}
+static inline bool _weu_concurrent_keyEquals(const _weu_concurrentSlot *slot, const _weu_concurrentKey *slotKey, const char *key, uint32_t keyLen, uint64_t hash) {
+    return slot->hash == hash && slotKey->length == keyLen && memcmp(slotKey->text, key, keyLen) == 0;
+}
+//  Lock free lookup, caller must be inside read section or hold shard lock.
+static bool _weu_concurrent_find(_weu_concurrentShard *shard, const char *key, uint32_t keyLen, uint64_t hash, void **valueOut) {
+    _weu_concurrentArray *data = __atomic_load_n(&shard->data, __ATOMIC_ACQUIRE);
+    uint32_t mask = data->length - 1;
+    uint32_t position = (uint32_t)hash & mask;
+    for (uint32_t i = 0; i < data->length; i++) {
+        _weu_concurrentSlot *slot = &data->slots[position];
+        _weu_concurrentKey *slotKey = __atomic_load_n(&slot->key, __ATOMIC_ACQUIRE);
+        if (slotKey == NULL) return false;
+        if (slotKey != _WEU_CONCURRENT_TOMBSTONE && _weu_concurrent_keyEquals(slot, slotKey, key, keyLen, hash)) {
+            if (valueOut != NULL) *valueOut = __atomic_load_n(&slot->value, __ATOMIC_ACQUIRE);
+            return true;
+        }
+        position = (position + 1) & mask;
+    }
+    return false;
+}
+//  Writer side, shard lock held. Returns slot of key or first empty slot.
+static _weu_concurrentSlot *_weu_concurrent_findSlot(_weu_concurrentShard *shard, const char *key, uint32_t keyLen, uint64_t hash) {
+    _weu_concurrentArray *data = shard->data;
+    uint32_t mask = data->length - 1;
+    uint32_t position = (uint32_t)hash & mask;
+    for (;;) {
+        _weu_concurrentSlot *slot = &data->slots[position];
+        if (slot->key == NULL) return slot;
+        if (slot->key != _WEU_CONCURRENT_TOMBSTONE && _weu_concurrent_keyEquals(slot, slot->key, key, keyLen, hash)) return slot;
+        position = (position + 1) & mask;
+    }
+}
+static void _weu_concurrent_freeRetired(const _weu_concurrentHashTable *table, _weu_retired *item) {
+    if (item->kind == _WEU_RETIRED_VALUE) { if (table->d != NULL) table->d(&item->data); }
+    else free(item->data);
+}
+//  Frees retired objects no reader can reach anymore.
+static void _weu_concurrent_reclaim(const _weu_concurrentHashTable *table, _weu_concurrentShard *shard) {
+    uint64_t epoch = _weu_epoch_tryAdvance();
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < shard->retiredLength; i++) {
+        if (shard->retired[i].epoch + 2 <= epoch)   _weu_concurrent_freeRetired(table, &shard->retired[i]);
+        else                                        shard->retired[kept++] = shard->retired[i];
+    }
+    shard->retiredLength = kept;
+}
+static void _weu_concurrent_retire(const _weu_concurrentHashTable *table, _weu_concurrentShard *shard, void *data, _weu_retiredKind kind) {
+    if (data == NULL || (kind == _WEU_RETIRED_VALUE && table->d == NULL)) return;
+    //  Unlink must be visible before retire epoch is read
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (shard->retiredLength == shard->retiredCapacity) {
+        shard->retiredCapacity = shard->retiredCapacity > 0 ? shard->retiredCapacity * 2 : WEU_CONCURRENT_RECLAIM_BATCH;
+        shard->retired = (_weu_retired*)realloc(shard->retired, sizeof(_weu_retired) * shard->retiredCapacity);
+    }
+    shard->retired[shard->retiredLength++] = (_weu_retired){
+        .data = data, .epoch = __atomic_load_n(&_weu_epoch.epoch, __ATOMIC_SEQ_CST), .kind = kind };
+    if (shard->retiredLength % WEU_CONCURRENT_RECLAIM_BATCH == 0) _weu_concurrent_reclaim(table, shard);
+}
+//  Publishes new slot array without tombstones, readers still on old array see consistent snapshot.
+static void _weu_concurrent_resize(const _weu_concurrentHashTable *table, _weu_concurrentShard *shard) {
+    uint64_t required = (uint64_t)(shard->count + 1) * 2 * 100 / WEU_CONCURRENT_MAX_LOAD;
+    uint32_t length = MIN_TABLE_SIZE;
+    while (length < required) length <<= 1;
+    _weu_concurrentArray *old = shard->data;
+    _weu_concurrentArray *data = _weu_concurrent_allocArray(length);
+    for (uint32_t i = 0; i < old->length; i++) {
+        _weu_concurrentSlot *slot = &old->slots[i];
+        if (slot->key == NULL || slot->key == _WEU_CONCURRENT_TOMBSTONE) continue;
+        uint32_t position = (uint32_t)slot->hash & (length - 1);
+        while (data->slots[position].key != NULL) position = (position + 1) & (length - 1);
+        data->slots[position] = *slot;
+    }
+    __atomic_store_n(&shard->data, data, __ATOMIC_RELEASE);
+    shard->used = shard->count;
+    _weu_concurrent_retire(table, shard, old, _WEU_RETIRED_MEMORY);
+}
+static weu_hashStatus _weu_concurrent_insert(weu_concurrentHashTable *t, const char *key, uint32_t keyLen, void *value, bool replace) {
+    _weu_concurrentHashTable *table = (_weu_concurrentHashTable*)t;
+    if (table == NULL || (key == NULL && keyLen > 0)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    uint64_t hash = weu_hash_wy(key, keyLen, table->seed);
+    _weu_concurrentShard *shard = _weu_concurrent_shard(table, hash);
+    pthread_mutex_lock(&shard->lock);
+    if ((uint64_t)(shard->used + 1) * 100 > (uint64_t)shard->data->length * WEU_CONCURRENT_MAX_LOAD) {
+        _weu_concurrent_resize(table, shard);
+    }
+    _weu_concurrentSlot *slot = _weu_concurrent_findSlot(shard, key, keyLen, hash);
+    if (slot->key != NULL) {
+        if (replace) {
+            void *old = __atomic_exchange_n(&slot->value, value, __ATOMIC_ACQ_REL);
+            if (old != value) _weu_concurrent_retire(table, shard, old, _WEU_RETIRED_VALUE);
+        }
+        pthread_mutex_unlock(&shard->lock);
+        return replace ? WEU_HASH_OK : WEU_HASH_EXISTS;
+    }
+    _weu_concurrentKey *stored = (_weu_concurrentKey*)malloc(sizeof(_weu_concurrentKey) + keyLen + 1);
+    stored->length = keyLen;
+    memcpy(stored->text, key, keyLen);
+    stored->text[keyLen] = '\0';
+    slot->hash = hash;
+    __atomic_store_n(&slot->value, value, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->key, stored, __ATOMIC_RELEASE);
+    __atomic_store_n(&shard->count, shard->count + 1, __ATOMIC_RELAXED);
+    ++shard->used;
+    pthread_mutex_unlock(&shard->lock);
+    return WEU_HASH_OK;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ALLOCATION
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+weu_concurrentHashTable *weu_concurrentHashTable_new(uint32_t shardCount, datafreefun d) {
+    uint32_t count = 1;
+    if (shardCount == 0) shardCount = WEU_CONCURRENT_DEFAULT_SHARDS;
+    while (count < shardCount && count < (1u << 24)) count <<= 1;
+    _weu_concurrentHashTable *out = (_weu_concurrentHashTable*)calloc(1, sizeof(_weu_concurrentHashTable));
+    out->shards     = (_weu_concurrentShardPadded*)calloc(count, sizeof(_weu_concurrentShardPadded));
+    out->shardMask  = count - 1;
+    out->seed       = weu_hash_randomSeed();
+    out->d          = d;
+    for (uint32_t i = 0; i < count; i++) {
+        pthread_mutex_init(&out->shards[i].shard.lock, NULL);
+        out->shards[i].shard.data = _weu_concurrent_allocArray(MIN_TABLE_SIZE);
+    }
+    return (weu_concurrentHashTable*)out;
+}
+void weu_concurrentHashTable_free(weu_concurrentHashTable **handle) {
+    _weu_concurrentHashTable *table = (_weu_concurrentHashTable*)*handle;
+    if (table == NULL) return;
+    for (uint32_t i = 0; i <= table->shardMask; i++) {
+        _weu_concurrentShard *shard = &table->shards[i].shard;
+        for (uint32_t j = 0; j < shard->retiredLength; j++) _weu_concurrent_freeRetired(table, &shard->retired[j]);
+        for (uint32_t j = 0; j < shard->data->length; j++) {
+            _weu_concurrentSlot *slot = &shard->data->slots[j];
+            if (slot->key == NULL || slot->key == _WEU_CONCURRENT_TOMBSTONE) continue;
+            if (table->d != NULL) table->d(&slot->value);
+            free(slot->key);
+        }
+        free(shard->retired);
+        free(shard->data);
+        pthread_mutex_destroy(&shard->lock);
+    }
+    free(table->shards);
+    free(table);
+    *handle = NULL;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  DATA
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+weu_hashStatus weu_concurrentHashTable_get(weu_concurrentHashTable *t, const char *key, uint32_t keyLen, void **valueOut) {
+    _weu_concurrentHashTable *table = (_weu_concurrentHashTable*)t;
+    if (valueOut != NULL) *valueOut = NULL;
+    if (table == NULL || (key == NULL && keyLen > 0)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    uint64_t hash = weu_hash_wy(key, keyLen, table->seed);
+    _weu_concurrentShard *shard = _weu_concurrent_shard(table, hash);
+    _weu_epochRecord *record = _weu_epoch_enter();
+    if (record == NULL) pthread_mutex_lock(&shard->lock);
+    bool found = _weu_concurrent_find(shard, key, keyLen, hash, valueOut);
+    if (record == NULL) pthread_mutex_unlock(&shard->lock);
+    else                _weu_epoch_leave(record);
+    return found ? WEU_HASH_OK : WEU_HASH_NOT_FOUND;
+}
+weu_hashStatus weu_concurrentHashTable_add(weu_concurrentHashTable *table, const char *key, uint32_t keyLen, void *value) {
+    return _weu_concurrent_insert(table, key, keyLen, value, false);
+}
+weu_hashStatus weu_concurrentHashTable_set(weu_concurrentHashTable *table, const char *key, uint32_t keyLen, void *value) {
+    return _weu_concurrent_insert(table, key, keyLen, value, true);
+}
+weu_hashStatus weu_concurrentHashTable_remove(weu_concurrentHashTable *t, const char *key, uint32_t keyLen) {
+    _weu_concurrentHashTable *table = (_weu_concurrentHashTable*)t;
+    if (table == NULL || (key == NULL && keyLen > 0)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    uint64_t hash = weu_hash_wy(key, keyLen, table->seed);
+    _weu_concurrentShard *shard = _weu_concurrent_shard(table, hash);
+    pthread_mutex_lock(&shard->lock);
+    _weu_concurrentSlot *slot = _weu_concurrent_findSlot(shard, key, keyLen, hash);
+    if (slot->key == NULL) {
+        pthread_mutex_unlock(&shard->lock);
+        return WEU_HASH_NOT_FOUND;
+    }
+    _weu_concurrentKey *removed = slot->key;
+    __atomic_store_n(&slot->key, _WEU_CONCURRENT_TOMBSTONE, __ATOMIC_RELEASE);
+    __atomic_store_n(&shard->count, shard->count - 1, __ATOMIC_RELAXED);
+    _weu_concurrent_retire(table, shard, removed, _WEU_RETIRED_MEMORY);
+    _weu_concurrent_retire(table, shard, slot->value, _WEU_RETIRED_VALUE);
+    pthread_mutex_unlock(&shard->lock);
+    return WEU_HASH_OK;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  READ SECTION
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool weu_concurrentHashTable_readBegin(weu_concurrentHashTable *table) {
+    if (table == NULL) return false;
+    return _weu_epoch_enter() != NULL;
+}
+void weu_concurrentHashTable_readEnd(weu_concurrentHashTable *table) {
+    if (table == NULL) return;
+    _weu_epoch_leave(_weu_epoch_record());
+}
+uint32_t weu_concurrentHashTable_count(weu_concurrentHashTable *t) {
+    _weu_concurrentHashTable *table = (_weu_concurrentHashTable*)t;
+    if (table == NULL) return 0;
+    uint32_t out = 0;
+    for (uint32_t i = 0; i <= table->shardMask; i++) out += __atomic_load_n(&table->shards[i].shard.count, __ATOMIC_RELAXED);
+    return out;
+}
+
+#endif
+#endif
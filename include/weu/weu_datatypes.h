@@ -20,6 +20,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  DEFINES
@@ -48,6 +49,11 @@
 
 typedef void (*datafreefun) ( void**);
 typedef bool (*datacompfun) ( void*, void* );
+// Hashtable CUSTOM key mode callbacks, key bytes, key length and table seed.
+typedef uint64_t (*keyhashfun) ( const void*, uint32_t, uint64_t );
+typedef bool (*keycompfun) ( const void*, const void*, uint32_t );
+// Hashtable snapshot writer callback, returns byte count of value copied to file.
+typedef uint32_t (*valuesizefun) ( const void* );
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  BITFIELD
 
@@ -66,6 +72,58 @@ typedef struct weu_string           { uint32_t length; char *text; uint32_t char
 // Stores up to 511 characters,
 // 512 including null terminator.
 typedef struct weu_stringNA         { uint32_t length; char text[512]; }                                    weu_stringNA;
+// string with small string optimization, 32 bytes.
+// Up to WEU_STRINGSSO_CAPACITY characters are stored inline, longer text is allocated.
+// Inline, last byte holds length, allocated, last byte is WEU_STRINGSSO_HEAP.
+// Zero initialized string is valid empty string.
+#define WEU_STRINGSSO_CAPACITY  30
+#define WEU_STRINGSSO_HEAP      0x80
+// reserved pads large so tag shares last byte with inline length on any pointer size.
+typedef union weu_stringSSO         { char small[WEU_STRINGSSO_CAPACITY + 2];
+                                      struct { char *text; uint32_t length, capacity;
+                                               char reserved[WEU_STRINGSSO_CAPACITY + 2 - sizeof(char*) - 2 * sizeof(uint32_t) - 1];
+                                               uint8_t tag; } large; } weu_stringSSO;
+// Fails to compile when tag is not last byte.
+typedef char weu_stringSSO_tagCheck[offsetof(weu_stringSSO, large.tag) == WEU_STRINGSSO_CAPACITY + 1 ? 1 : -1];
+// Needle compiled for repeated substring search.
+// shift - bad character shift table, used for needles of WEU_STRING_LONG_NEEDLE bytes or more
+typedef struct weu_stringNeedle     { char *text; uint32_t length; uint32_t shift[256]; }                  weu_stringNeedle;
+// Iterator over tokens of text, tokens are slices of text and nothing is allocated.
+// delimiter        - single character delimiter, used when delimiterLength is 0
+// delimiterText    - multi character delimiter of delimiterLength bytes
+// pos              - start of next token, above length when text is exhausted
+typedef struct weu_stringTokenizer  { const char *text; uint32_t length, pos; const char *delimiterText; uint32_t delimiterLength; char delimiter; } weu_stringTokenizer;
+// Iterator over lines of text, lines are slices of text and text is never changed.
+// pos      - start of next line
+// stripCR  - drops \r before \n of each line
+typedef struct weu_stringLineIterator { const char *text; uint32_t length, pos; bool stripCR; }           weu_stringLineIterator;
+// 256 bit set of byte values, built from [a-z!0-9] condition syntax of string expressions.
+// nibbles  - same set as lookup tables for SIMD scanning, byte x is in class when
+//            bit (x >> 4) & 7 of nibbles[(x >> 7) * 16 + (x & 15)] is set
+typedef struct weu_charClass        { uint64_t bits[4]; uint8_t nibbles[32]; }                             weu_charClass;
+typedef enum weu_expressionKind     { WEU_EXPRESSION_LITERAL, WEU_EXPRESSION_CHAR, WEU_EXPRESSION_STRING } weu_expressionKind;
+// Part of compiled expression, literal text or run of count char or string tests.
+// offset, length   - literal text in literals of expression
+// ends             - characters ending tested string
+// condition        - characters accepted by tests
+typedef struct weu_expressionPart   { uint8_t kind, count; uint32_t offset, length; weu_charClass ends, condition; } weu_expressionPart;
+// Expression compiled once for repeated matching.
+// varyingCount     - chars and strings tested, captures written by weu_expression_match
+typedef struct weu_expression       { weu_expressionPart *parts; uint32_t partCount, varyingCount; char *literals; } weu_expression;
+// Expressions compiled together, distinct literals of all patterns form one Aho-Corasick automaton.
+// patterns         - patternCount compiled expressions, index is pattern id
+// captureOffsets   - first capture of each pattern in captures array of captureCount slices
+// byteClasses      - class of each byte, bytes found in no literal share class 0
+// transitions      - stateCount * classCount next states, state 0 is root
+// keywords         - literal ended by each state, WEU_INDEX_INVALID for none
+// outputs          - nearest suffix state ending literal, 0 for none
+// references       - patterns of each literal, literal k owns references[referenceStarts[k]] up to referenceStarts[k + 1]
+// required         - distinct literals of each pattern, patterns without literals are listed in unfiltered
+// pass, *Stamps    - scratch of weu_expressionSet_match, marks literals and patterns seen by current text
+typedef struct weu_expressionSet    { weu_expression **patterns; uint32_t patternCount, captureCount; uint32_t *captureOffsets;
+                                      uint8_t byteClasses[256]; uint32_t classCount, stateCount, keywordCount; uint32_t *transitions, *keywords, *outputs;
+                                      uint32_t *referenceStarts, *references, *required, *unfiltered; uint32_t unfilteredCount;
+                                      uint32_t pass; uint32_t *keywordStamps, *patternStamps, *found, *candidates; } weu_expressionSet;
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  LIST
 
@@ -77,8 +135,116 @@ typedef struct weu_pair             { void *data; uint32_t dataSize1, dataSize2;
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  HASHTABLE
 
-typedef struct weu_hashItem         { weu_string *key; void *value; bool inUse; }           weu_hashItem;
-typedef struct weu_hashTable        { uint32_t length; weu_hashItem *data; datafreefun d; } weu_hashTable;
+// Entry of hashtable, entries are kept dense in insertion order.
+// Stores cached hash and offset/length of key bytes inside table owned key arena.
+// keyLength is set to WEU_HASHITEM_DELETED for removed entries.
+typedef struct weu_hashItem         { uint64_t hash; uint32_t keyOffset, keyLength; void *value; }           weu_hashItem;
+// Slot of sparse open addressing index into entries.
+// entry    - entry index, WEU_HASHITEM_EMPTY / WEU_HASHITEM_DELETED for unused slots
+// hash     - low 32 bits of entry hash, probes skip entry when it differs
+typedef struct weu_hashSlot         { uint32_t entry, hash; }                                                weu_hashSlot;
+// Probing engine of hashtable.
+// LINEAR   - probes slot array one slot at a time
+// GROUP    - control byte with 7 bit hash fragment per slot, probes 16 slots at once
+typedef enum weu_hashEngine         { WEU_HASHENGINE_LINEAR, WEU_HASHENGINE_GROUP } weu_hashEngine;
+// Hash function of hashtable keys.
+// WY       - 64 bit word at a time hash, default
+// CRC32C   - SSE4.2 crc32 instruction when available at runtime
+// FNV      - byte wise FNV-1a, for compatibility
+typedef enum weu_hashFunction       { WEU_HASHFUN_WY, WEU_HASHFUN_CRC32C, WEU_HASHFUN_FNV } weu_hashFunction;
+// Key type of hashtable.
+// TEXT         - byte string keys of any length, default
+// INT32/INT64  - integer keys kept inline in slot
+// POD          - fixed keySize byte keys compared with memcmp
+// CUSTOM       - keys hashed and compared with keyHash and keyCompare callbacks
+typedef enum weu_hashKeyMode        { WEU_HASHKEY_TEXT, WEU_HASHKEY_INT32, WEU_HASHKEY_INT64, WEU_HASHKEY_POD, WEU_HASHKEY_CUSTOM } weu_hashKeyMode;
+// Operation counters of hashtable, present only when WEU_HASHTABLE_STATS is defined.
+// hits, misses - lookups including removal, failedInserts - insertions of present key
+typedef struct weu_hashCounters     { uint64_t hits, misses, inserts, failedInserts; }                     weu_hashCounters;
+// length       - slot count, power of two
+// count        - stored items
+// deleted      - removed slots not yet reclaimed
+// data         - entries in insertion order, dataLength includes removed entries not yet compacted
+// slots        - sparse index into data
+// ctrl         - control bytes of GROUP engine, NULL for LINEAR
+// keys         - arena with null terminated key bytes of stored keys
+// oldSlots     - previous slot array while incremental rehash is in progress, NULL otherwise
+typedef struct weu_hashTable        { uint32_t length, count, deleted; weu_hashItem *data; uint32_t dataLength, dataCapacity;
+                                      weu_hashSlot *slots; uint8_t *ctrl; char *keys; uint32_t keysLength, keysCapacity;
+                                      weu_hashSlot *oldSlots; uint8_t *oldCtrl; uint32_t oldLength, rehashPos;
+                                      weu_hashEngine engine; weu_hashFunction hashFun; uint64_t seed;
+                                      weu_hashKeyMode keyMode; uint32_t keySize; keyhashfun keyHash; keycompfun keyCompare; datafreefun d;
+#ifdef WEU_HASHTABLE_STATS
+                                      weu_hashCounters counters;
+#endif
+                                    } weu_hashTable;
+// Read only hashtable made by weu_hashtable_freeze, indexed by minimal perfect hash of its keys.
+// count        - stored items, every entry of data is in use
+// slotCount    - range keys are displaced into, slightly above count
+// pilots       - displacement per bucket of keys, bucketCount entries
+// remap        - entry of positions count..slotCount-1
+// salt         - mixed into displaced positions, changed when build is retried
+typedef struct weu_frozenHashTable  { uint32_t count, slotCount, bucketCount; uint16_t *pilots; uint32_t *remap; weu_hashItem *data; char *keys;
+                                      uint64_t salt; weu_hashFunction hashFun; uint64_t seed;
+                                      weu_hashKeyMode keyMode; uint32_t keySize; keyhashfun keyHash; keycompfun keyCompare; datafreefun d; } weu_frozenHashTable;
+// Result of hashtable text and slice functions.
+typedef enum weu_hashStatus         { WEU_HASH_OK, WEU_HASH_NOT_FOUND, WEU_HASH_EXISTS, WEU_HASH_INVALID } weu_hashStatus;
+// Hashtable creation options, zero initialized fields use defaults.
+// seed - 0 picks random seed per table
+typedef struct weu_hashTableDesc    { uint32_t size; datafreefun d; weu_hashEngine engine; weu_hashFunction hash; uint64_t seed;
+                                      weu_hashKeyMode keyMode; uint32_t keySize; keyhashfun keyHash; keycompfun keyCompare; } weu_hashTableDesc;
+// Cache creation options, table options are used for table holding cached entries.
+// maxEntries, maxBytes - limits of cache, 0 for no limit
+typedef struct weu_hashCacheDesc    { weu_hashTableDesc table; uint32_t maxEntries; uint64_t maxBytes; }    weu_hashCacheDesc;
+#ifndef WEU_HASHTABLE_STATS_HISTOGRAM
+#define WEU_HASHTABLE_STATS_HISTOGRAM 16
+#endif
+// Report of weu_hashtable_stats.
+// probe length     - slots (LINEAR) or groups of 16 slots (GROUP) probed to reach key, 1 when key is in home slot
+// probeHistogram   - item count per probe length, last bucket holds longer probes too
+// tombstones       - deleted slots, removedEntries - removed entries not yet compacted
+// loadFactor       - used and deleted slots per slot, compared with maximum load on insertion
+typedef struct weu_hashTableStats   { uint32_t count, length, tombstones, removedEntries, maxProbe; float loadFactor, meanProbe;
+                                      uint32_t probeHistogram[WEU_HASHTABLE_STATS_HISTOGRAM]; weu_hashCounters counters; } weu_hashTableStats;
+// Header of hashtable snapshot file, every offset is from start of file.
+// byteOrder        - 0x01020304 written by host, file is rejected by host of other byte order
+// inlineValues     - 1 if entry value holds value itself, 0 if it is offset into value bytes
+// pilots, remap    - minimal perfect hash index, same layout as weu_frozenHashTable
+typedef struct weu_hashSnapshotHeader { char magic[8]; uint32_t version, byteOrder, headerSize, entrySize;
+                                      uint32_t count, slotCount, bucketCount, keyMode, keySize, hashFun, inlineValues, reserved;
+                                      uint64_t seed, salt, fileSize;
+                                      uint64_t pilotsOffset, remapOffset, entriesOffset, keysOffset, keysLength, valuesOffset, valuesLength; } weu_hashSnapshotHeader;
+// Entry of snapshot file, keyOffset and value are offsets into key and value bytes.
+typedef struct weu_hashSnapshotEntry  { uint64_t hash, value; uint32_t keyOffset, keyLength, valueLength, reserved; } weu_hashSnapshotEntry;
+// Snapshot file opened by weu_io_mapHashtable, sections point into mapped file.
+typedef struct weu_hashSnapshot     { const uint8_t *base; uint64_t size; bool mapped; const weu_hashSnapshotHeader *header;
+                                      const uint16_t *pilots; const uint32_t *remap; const weu_hashSnapshotEntry *entries;
+                                      const char *keys; const uint8_t *values; } weu_hashSnapshot;
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  STRING POOL
+
+// Interned strings, every distinct byte sequence is stored once.
+// count        - interned strings, symbols are 0 to count - 1 in interning order
+// length       - slot count of index, power of two
+// slots        - open addressing index, entry is symbol
+// strings      - blocks of WEU_STRINGPOOL_BLOCK canonical strings, addresses stay stable
+// chunks       - text arena chunks, last one is filled, chunkUsed / chunkSize bytes
+// bytes        - text bytes of interned strings, terminators included
+typedef struct weu_stringPool       { uint32_t count, length; weu_hashSlot *slots; weu_string **strings; uint32_t blockCount;
+                                      char **chunks; uint32_t chunkCount, chunkUsed, chunkSize; uint64_t seed, bytes; } weu_stringPool;
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  STRING BUILDER
+
+// Text assembled in fixed size chunks, appending never moves written text.
+// chunks       - chunkCount chunks of chunkSize bytes, every chunk but last is full
+// used         - bytes written to last chunk
+// length       - bytes written in total
+typedef struct weu_stringBuilder    { char **chunks; uint32_t chunkCount, chunkCapacity, chunkSize, used; uint64_t length; } weu_stringBuilder;
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  NUMBER CONVERSION
+
+// Result of weu_charconv parse functions.
+typedef enum weu_charconvStatus     { WEU_CHARCONV_OK, WEU_CHARCONV_INVALID, WEU_CHARCONV_OUT_OF_RANGE } weu_charconvStatus;
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  ALLOCATE PRIMARY TYPES
 
@@ -0,0 +1,256 @@
+/*///////////////////////////////////////////////////////////////////////////////////
+//  SPDX-License-Identifier: Unlicense
+/////////////////////////////////////////////////////////////////////////////////////
+//  USAGE
+//  Functions are defined as extern.
+//  To implement somewhere in source file before including header file
+//  #define WEU_IMPLEMENTATION
+//  Implementation should be defined once.
+//
+//  #define WEU_IMPLEMENTATION
+//  #include <path_to_lib/weu_master.h>
+//
+//  To include all weu library in souce file at once, include weu_master.h
+*////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef weu_hashcache_h
+#define weu_hashcache_h
+
+#define WEUDEF extern
+
+#include "weu_hashtable.h"
+
+//  Hashtable with bounded entry count and byte budget, evicts with CLOCK.
+//  Every entry of table has reference bit set on hit, clock hand sweeps entries in order,
+//  clears set bits and evicts first entry whose bit is clear. Hits only set bit, nothing is relinked.
+//  New entries start with clear bit, so keys never read again leave before keys read twice.
+//  Evicted, removed and replaced values are freed with datafreefun of table.
+typedef struct weu_hashCache {} weu_hashCache;
+
+//  At least one of maxEntries and maxBytes must be set, 0 means no limit.
+//  Entry costs bytes passed to put plus key length against maxBytes.
+WEUDEF weu_hashCache *weu_hashCache_new(const weu_hashCacheDesc *desc);
+WEUDEF void weu_hashCache_free(weu_hashCache **handle);
+
+//  Returns WEU_HASH_OK on hit and WEU_HASH_NOT_FOUND on miss.
+WEUDEF weu_hashStatus weu_hashCache_get(weu_hashCache *cache, const char *key, uint32_t keyLen, void **valueOut);
+//  Adds key or replaces value of present key, evicts until entry fits.
+//  Returns WEU_HASH_INVALID if entry alone exceeds maxBytes, value is then not stored.
+WEUDEF weu_hashStatus weu_hashCache_put(weu_hashCache *cache, const char *key, uint32_t keyLen, void *value, uint32_t bytes);
+WEUDEF weu_hashStatus weu_hashCache_remove(weu_hashCache *cache, const char *key, uint32_t keyLen);
+
+//  For INT32 and INT64 key modes.
+WEUDEF weu_hashStatus weu_hashCache_getInt(weu_hashCache *cache, uint64_t key, void **valueOut);
+WEUDEF weu_hashStatus weu_hashCache_putInt(weu_hashCache *cache, uint64_t key, void *value, uint32_t bytes);
+WEUDEF weu_hashStatus weu_hashCache_removeInt(weu_hashCache *cache, uint64_t key);
+
+WEUDEF uint32_t weu_hashCache_count(const weu_hashCache *cache);
+WEUDEF uint64_t weu_hashCache_bytes(const weu_hashCache *cache);
+//  Evictions done by put since cache was created.
+WEUDEF uint64_t weu_hashCache_evictions(const weu_hashCache *cache);
+
+#ifdef WEU_IMPLEMENTATION
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTERNAL
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//  Cache state is indexed by entry index of table. Removed entries are refilled through free list
+//  and never appended over, so table never compacts on its own and entry indexes stay stable.
+//  referenced   - CLOCK bit per entry
+//  cost         - bytes charged per entry
+//  holes        - removed entries waiting for reuse
+//  keyBytes     - key arena bytes of live entries, arena is compacted when it is mostly dead keys
+typedef struct _weu_hashCache {
+    weu_hashTable *table;
+    uint8_t *referenced;
+    uint32_t *cost, *holes;
+    uint32_t capacity, holeCount, hand, maxEntries;
+    uint64_t maxBytes, bytes, keyBytes, evictions;
+} _weu_hashCache;
+
+//  Keeps per entry arrays as long as entry array of table.
+static void _weu_hashCache_fit(_weu_hashCache *cache) {
+    uint32_t capacity = cache->table->dataCapacity;
+    if (capacity <= cache->capacity) return;
+    cache->referenced   = (uint8_t*)realloc(cache->referenced, capacity);
+    cache->cost         = (uint32_t*)realloc(cache->cost, sizeof(uint32_t) * capacity);
+    cache->holes        = (uint32_t*)realloc(cache->holes, sizeof(uint32_t) * capacity);
+    cache->capacity     = capacity;
+}
+static uint32_t _weu_hashCache_keyBytes(const _weu_hashCache *cache, uint32_t keyLen) {
+    return _weu_hashtable_intKeyed(cache->table) ? 0 : keyLen + 1;
+}
+//  Frees entry of table and charges it back, entry becomes hole.
+static void _weu_hashCache_removeEntry(_weu_hashCache *cache, uint32_t entry) {
+    weu_hashTable *table = cache->table;
+    const weu_hashItem *item = &table->data[entry];
+    bool inOld = false;
+    uint32_t position = _weu_hashtable_findEntry(table->slots, table->ctrl, table->length, entry, item->hash);
+    if (position == WEU_INDEX_INVALID && table->oldSlots != NULL) {
+        position = _weu_hashtable_findEntry(table->oldSlots, table->oldCtrl, table->oldLength, entry, item->hash);
+        inOld = true;
+    }
+    cache->bytes    -= cache->cost[entry];
+    cache->keyBytes -= _weu_hashCache_keyBytes(cache, item->keyLength);
+    cache->holes[cache->holeCount++] = entry;
+    _weu_hashtable_removeAt(table, inOld, position);
+}
+//  Sweeps from hand, clearing reference bits, until entry with clear bit other than keep is evicted.
+static void _weu_hashCache_evict(_weu_hashCache *cache, uint32_t keep) {
+    weu_hashTable *table = cache->table;
+    for (;;) {
+        if (cache->hand >= table->dataLength) cache->hand = 0;
+        uint32_t entry = cache->hand++;
+        if (entry == keep || !_weu_hashtable_inUse(&table->data[entry])) continue;
+        if (cache->referenced[entry]) {
+            cache->referenced[entry] = 0;
+            continue;
+        }
+        _weu_hashCache_removeEntry(cache, entry);
+        ++cache->evictions;
+        return;
+    }
+}
+//  Compacts key arena once dead keys outweigh live ones, live entries keep their order
+//  so cache arrays are moved to rank of entry among live entries.
+static void _weu_hashCache_compact(_weu_hashCache *cache) {
+    weu_hashTable *table = cache->table;
+    if (table->keysLength <= MIN_KEYS_CAPACITY || cache->keyBytes * 2 > table->keysLength) return;
+    uint32_t live = 0, hand = 0;
+    for (uint32_t i = 0; i < table->dataLength; i++) {
+        if (i == cache->hand) hand = live;
+        if (!_weu_hashtable_inUse(&table->data[i])) continue;
+        cache->referenced[live] = cache->referenced[i];
+        cache->cost[live]       = cache->cost[i];
+        ++live;
+    }
+    _weu_hashtable_compact(table, table->length);
+    cache->hand         = hand;
+    cache->holeCount    = 0;
+}
+static weu_hashStatus _weu_hashCache_get(_weu_hashCache *cache, const char *key, uint32_t keyLen, uint64_t hash, void **valueOut) {
+    uint32_t entry = _weu_hashtable_locate(cache->table, key, keyLen, hash, NULL, NULL);
+    if (entry == WEU_INDEX_INVALID) return WEU_HASH_NOT_FOUND;
+    cache->referenced[entry] = 1;
+    if (valueOut != NULL) *valueOut = cache->table->data[entry].value;
+    return WEU_HASH_OK;
+}
+static weu_hashStatus _weu_hashCache_put(_weu_hashCache *cache, const char *key, uint32_t keyLen, uint64_t hash, void *value, uint32_t bytes) {
+    weu_hashTable *table = cache->table;
+    uint64_t cost = (uint64_t)bytes + (_weu_hashtable_intKeyed(table) ? 0 : keyLen);
+    if (cost > UINT32_MAX || (cache->maxBytes > 0 && cost > cache->maxBytes)) return WEU_HASH_INVALID;
+    uint32_t entry = _weu_hashtable_locate(table, key, keyLen, hash, NULL, NULL);
+    if (entry != WEU_INDEX_INVALID) {
+        weu_hashItem *item = &table->data[entry];
+        if (table->d != NULL && item->value != value) table->d(&item->value);
+        item->value = value;
+        cache->bytes += cost - cache->cost[entry];
+        cache->cost[entry] = (uint32_t)cost;
+        //  Replaced entry is protected for one sweep, others go first
+        cache->referenced[entry] = 1;
+        while (cache->maxBytes > 0 && cache->bytes > cache->maxBytes && table->count > 1) _weu_hashCache_evict(cache, entry);
+        return WEU_HASH_OK;
+    }
+    while (table->count > 0 && ((cache->maxEntries > 0 && table->count >= cache->maxEntries) ||
+                                (cache->maxBytes > 0 && cache->bytes + cost > cache->maxBytes))) {
+        _weu_hashCache_evict(cache, WEU_INDEX_INVALID);
+    }
+    entry = cache->holeCount > 0 ? cache->holes[--cache->holeCount] : WEU_INDEX_INVALID;
+    weu_hashStatus status = _weu_hashtable_insertAt(table, entry, key, keyLen, hash, value);
+    if (status != WEU_HASH_OK) {
+        if (entry != WEU_INDEX_INVALID) cache->holes[cache->holeCount++] = entry;
+        return status;
+    }
+    if (entry == WEU_INDEX_INVALID) {
+        entry = table->dataLength - 1;
+        _weu_hashCache_fit(cache);
+    }
+    cache->referenced[entry]    = 0;
+    cache->cost[entry]          = (uint32_t)cost;
+    cache->bytes                += cost;
+    cache->keyBytes             += _weu_hashCache_keyBytes(cache, keyLen);
+    _weu_hashCache_compact(cache);
+    return WEU_HASH_OK;
+}
+static weu_hashStatus _weu_hashCache_remove(_weu_hashCache *cache, const char *key, uint32_t keyLen, uint64_t hash) {
+    uint32_t entry = _weu_hashtable_locate(cache->table, key, keyLen, hash, NULL, NULL);
+    if (entry == WEU_INDEX_INVALID) return WEU_HASH_NOT_FOUND;
+    _weu_hashCache_removeEntry(cache, entry);
+    return WEU_HASH_OK;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ALLOCATION
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+weu_hashCache *weu_hashCache_new(const weu_hashCacheDesc *desc) {
+    if (desc == NULL || (desc->maxEntries == 0 && desc->maxBytes == 0)) return NULL;
+    _weu_hashCache *out = (_weu_hashCache*)calloc(1, sizeof(_weu_hashCache));
+    out->table      = weu_hashtable_newDesc(&desc->table);
+    out->maxEntries = desc->maxEntries;
+    out->maxBytes   = desc->maxBytes;
+    if (desc->maxEntries > 0) weu_hashtable_reserve(out->table, desc->maxEntries);
+    _weu_hashCache_fit(out);
+    return (weu_hashCache*)out;
+}
+void weu_hashCache_free(weu_hashCache **handle) {
+    _weu_hashCache *cache = (_weu_hashCache*)(*handle);
+    if (cache == NULL) return;
+    weu_hashtable_free(&cache->table);
+    free(cache->referenced);
+    free(cache->cost);
+    free(cache->holes);
+    free(cache);
+    *handle = NULL;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  DATA
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+weu_hashStatus weu_hashCache_get(weu_hashCache *cache, const char *key, uint32_t keyLen, void **valueOut) {
+    if (valueOut != NULL) *valueOut = NULL;
+    _weu_hashCache *c = (_weu_hashCache*)cache;
+    if (c == NULL || (key == NULL && keyLen > 0) || !_weu_hashtable_acceptsBytes(c->table, keyLen)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    return _weu_hashCache_get(c, key, keyLen, _weu_hashtable_hash(c->table, key, keyLen), valueOut);
+}
+weu_hashStatus weu_hashCache_put(weu_hashCache *cache, const char *key, uint32_t keyLen, void *value, uint32_t bytes) {
+    _weu_hashCache *c = (_weu_hashCache*)cache;
+    if (c == NULL || (key == NULL && keyLen > 0) || !_weu_hashtable_acceptsBytes(c->table, keyLen)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    return _weu_hashCache_put(c, key, keyLen, _weu_hashtable_hash(c->table, key, keyLen), value, bytes);
+}
+weu_hashStatus weu_hashCache_remove(weu_hashCache *cache, const char *key, uint32_t keyLen) {
+    _weu_hashCache *c = (_weu_hashCache*)cache;
+    if (c == NULL || (key == NULL && keyLen > 0) || !_weu_hashtable_acceptsBytes(c->table, keyLen)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    return _weu_hashCache_remove(c, key, keyLen, _weu_hashtable_hash(c->table, key, keyLen));
+}
+weu_hashStatus weu_hashCache_getInt(weu_hashCache *cache, uint64_t key, void **valueOut) {
+    if (valueOut != NULL) *valueOut = NULL;
+    _weu_hashCache *c = (_weu_hashCache*)cache;
+    if (c == NULL || !_weu_hashtable_acceptsInt(c->table, key)) return WEU_HASH_INVALID;
+    return _weu_hashCache_get(c, NULL, sizeof(uint64_t), weu_hash_int(key, c->table->seed), valueOut);
+}
+weu_hashStatus weu_hashCache_putInt(weu_hashCache *cache, uint64_t key, void *value, uint32_t bytes) {
+    _weu_hashCache *c = (_weu_hashCache*)cache;
+    if (c == NULL || !_weu_hashtable_acceptsInt(c->table, key)) return WEU_HASH_INVALID;
+    return _weu_hashCache_put(c, NULL, sizeof(uint64_t), weu_hash_int(key, c->table->seed), value, bytes);
+}
+weu_hashStatus weu_hashCache_removeInt(weu_hashCache *cache, uint64_t key) {
+    _weu_hashCache *c = (_weu_hashCache*)cache;
+    if (c == NULL || !_weu_hashtable_acceptsInt(c->table, key)) return WEU_HASH_INVALID;
+    return _weu_hashCache_remove(c, NULL, sizeof(uint64_t), weu_hash_int(key, c->table->seed));
+}
+uint32_t weu_hashCache_count(const weu_hashCache *cache) {
+    return cache != NULL ? ((const _weu_hashCache*)cache)->table->count : 0;
+}
+uint64_t weu_hashCache_bytes(const weu_hashCache *cache) {
+    return cache != NULL ? ((const _weu_hashCache*)cache)->bytes : 0;
+}
+uint64_t weu_hashCache_evictions(const weu_hashCache *cache) {
+    return cache != NULL ? ((const _weu_hashCache*)cache)->evictions : 0;
+}
+
+#endif
+#endif
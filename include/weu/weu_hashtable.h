@@ -24,21 +24,94 @@
 #include <stdlib.h>
 
 #define MIN_TABLE_SIZE      16
+#define MAX_TABLE_SIZE      0x80000000u
+#define MIN_KEYS_CAPACITY   256
 
 #define FNV_PRIME_32        0x01000193
 #define FNV_OFF_BASIS_32    0x811c9dc5
+#define FNV_PRIME_64        0x00000100000001b3ULL
+#define FNV_OFF_BASIS_64    0xcbf29ce484222325ULL
+
+//  Define WEU_HASHTABLE_DEBUG to print missing and duplicate keys passed to weu_string key functions.
+#ifdef WEU_HASHTABLE_DEBUG
+#include <stdio.h>
+#define WEU_HASHTABLE_LOG(FMT, KEY) printf(FMT, KEY)
+#else
+#define WEU_HASHTABLE_LOG(FMT, KEY) ((void)0)
+#endif
+
+#define WEU_HASHITEM_EMPTY      0xffffffff
+#define WEU_HASHITEM_DELETED    0xfffffffe
+
+//  Maximum percentage of used and deleted slots before table grows.
+#ifndef WEU_HASHTABLE_MAX_LOAD
+#define WEU_HASHTABLE_MAX_LOAD  75
+#endif
+//  Maximum load percentage of WEU_HASHENGINE_GROUP tables.
+#ifndef WEU_HASHTABLE_GROUP_MAX_LOAD
+#define WEU_HASHTABLE_GROUP_MAX_LOAD 87
+#endif
+//  Old slots moved to new slot array per table operation while rehashing.
+#ifndef WEU_HASHTABLE_REHASH_STEP
+#define WEU_HASHTABLE_REHASH_STEP 64
+#endif
+//  Keys hashed and prefetched together by batch functions before probing.
+#ifndef WEU_HASHTABLE_BATCH
+#define WEU_HASHTABLE_BATCH 16
+#endif
+//  Define WEU_HASHTABLE_STATS to count table operations and enable weu_hashtable_stats.
+#ifdef WEU_HASHTABLE_STATS
+#define _WEU_HASHTABLE_COUNT(TABLE, COUNTER) (++(TABLE)->counters.COUNTER)
+#else
+#define _WEU_HASHTABLE_COUNT(TABLE, COUNTER) ((void)0)
+#endif
+//  Average keys per bucket of frozen table, index costs 16 / WEU_HASHTABLE_FROZEN_BUCKET bits per key.
+#ifndef WEU_HASHTABLE_FROZEN_BUCKET
+#define WEU_HASHTABLE_FROZEN_BUCKET 6
+#endif
+//  Salts tried by weu_hashtable_freeze before it gives up.
+#ifndef WEU_HASHTABLE_FROZEN_ATTEMPTS
+#define WEU_HASHTABLE_FROZEN_ATTEMPTS 4
+#endif
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  HASH
 
 WEUDEF unsigned int weu_hash_FNV(const char *str, int strLen);
 WEUDEF unsigned int weu_hash_strFNV(weu_string *str);
+
+//  64 bit FNV-1a over unsigned bytes with seed mixed into offset basis, full width keeps
+//  frozen index and concurrent table shards working, both use high hash bits.
+WEUDEF uint64_t weu_hash_FNVSeeded(const void *data, uint32_t length, uint64_t seed);
+//  64 bit hash reading 8 bytes per step, wyhash construction.
+WEUDEF uint64_t weu_hash_wy(const void *data, uint32_t length, uint64_t seed);
+//  CRC32C based hash, uses SSE4.2 crc32 instruction when cpu supports it, software table otherwise.
+WEUDEF uint64_t weu_hash_crc32c(const void *data, uint32_t length, uint64_t seed);
+WEUDEF uint64_t weu_hash(weu_hashFunction fun, const void *data, uint32_t length, uint64_t seed);
+//  Bijective integer mixer, distinct keys never share hash for same seed.
+WEUDEF uint64_t weu_hash_int(uint64_t key, uint64_t seed);
+//  Seed from time, clock and address entropy, used for tables created with seed 0.
+WEUDEF uint64_t weu_hash_randomSeed(void);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  ALLOCATION
 
+//  Allocates slot array only, items are appended to dense entry array in insertion order and
+//  key bytes are stored in table owned arena on insertion.
+//  Size is rounded up to power of two. Table grows when WEU_HASHTABLE_MAX_LOAD is reached,
+//  slots are moved to new slot array incrementally, WEU_HASHTABLE_REHASH_STEP slots per operation.
 WEUDEF weu_hashTable *weu_hashtable_new(int size, datafreefun d);
+//  Creates table with options, example - weu_hashtable_newDesc(&(weu_hashTableDesc){.size = 1024, .engine = WEU_HASHENGINE_GROUP})
+//  Default hash is WEU_HASHFUN_WY with random per table seed.
+WEUDEF weu_hashTable *weu_hashtable_newDesc(const weu_hashTableDesc *desc);
 WEUDEF void weu_hashtable_free(weu_hashTable **handle);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CAPACITY
+
+//  Grows table so count items can be stored without further growth. Rehashes at once.
+WEUDEF void weu_hashtable_reserve(weu_hashTable *table, uint32_t count);
+//  Shrinks slot array to smallest size for current count, drops removed entries and compacts key arena.
+WEUDEF void weu_hashtable_shrinkToFit(weu_hashTable *table);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
 //  DATA
 
 WEUDEF void* weu_hashtable_getValue(weu_hashTable *table, weu_string *key, bool freeKeyOnDone);
@@ -47,18 +120,534 @@ WEUDEF void* weu_hashtable_getValueByIndex(weu_hashTable *table, unsigned int in
 WEUDEF void weu_hashtable_addItem(weu_hashTable *table, weu_string *key, void *value, bool freeKeyOnDone);
 WEUDEF void weu_hashtable_removeItem(weu_hashTable *table, weu_string *key, bool freeKeyOnDone);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TEXT AND SLICE KEYS
+//  Key is hashed once, never copied to heap and nothing is printed.
+//  Returns WEU_HASH_OK, WEU_HASH_NOT_FOUND on miss, WEU_HASH_EXISTS on duplicate insert,
+//  WEU_HASH_INVALID on NULL table or key and on insert past 4 GiB of stored key bytes.
+
+//  valueOut can be NULL to only test if key is present
+WEUDEF weu_hashStatus weu_hashtable_getText(weu_hashTable *table, const char *key, uint32_t keyLen, void **valueOut);
+WEUDEF weu_hashStatus weu_hashtable_addText(weu_hashTable *table, const char *key, uint32_t keyLen, void *value);
+WEUDEF weu_hashStatus weu_hashtable_removeText(weu_hashTable *table, const char *key, uint32_t keyLen);
+
+WEUDEF weu_hashStatus weu_hashtable_getSlice(weu_hashTable *table, weu_string key, void **valueOut);
+WEUDEF weu_hashStatus weu_hashtable_addSlice(weu_hashTable *table, weu_string key, void *value);
+WEUDEF weu_hashStatus weu_hashtable_removeSlice(weu_hashTable *table, weu_string key);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTEGER AND FIXED SIZE KEYS
+//  Set with weu_hashTableDesc keyMode.
+//  INT32, INT64 - key is kept in slot as its bijective hash, no key arena and no key compare
+//  POD          - keySize bytes stored in arena and compared with memcmp
+//  CUSTOM       - keyHash and keyCompare callbacks, keys of any length through text functions
+//  Functions return WEU_HASH_INVALID when used with table of other key mode.
+
+WEUDEF weu_hashStatus weu_hashtable_getInt(weu_hashTable *table, uint64_t key, void **valueOut);
+WEUDEF weu_hashStatus weu_hashtable_addInt(weu_hashTable *table, uint64_t key, void *value);
+WEUDEF weu_hashStatus weu_hashtable_removeInt(weu_hashTable *table, uint64_t key);
+//  Returns false if slot is not in use.
+WEUDEF bool weu_hashtable_getIntByIndex(weu_hashTable *table, unsigned int index, uint64_t *keyOut);
+
+//  Reads keySize bytes from key, for POD and CUSTOM tables.
+WEUDEF weu_hashStatus weu_hashtable_getKey(weu_hashTable *table, const void *key, void **valueOut);
+WEUDEF weu_hashStatus weu_hashtable_addKey(weu_hashTable *table, const void *key, void *value);
+WEUDEF weu_hashStatus weu_hashtable_removeKey(weu_hashTable *table, const void *key);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  BATCH
+//  Keys are hashed and their slots prefetched WEU_HASHTABLE_BATCH at a time before probing,
+//  hides memory latency of independent lookups on tables larger than cache.
+//  Keys not valid for table key mode are skipped.
+
+//  out receives value or NULL for every key, returns count of found keys.
+WEUDEF uint32_t weu_hashtable_getValues(weu_hashTable *table, const weu_string *keys, uint32_t n, void **out);
+//  Returns count of added keys, keys already present are skipped.
+WEUDEF uint32_t weu_hashtable_addValues(weu_hashTable *table, const weu_string *keys, void *const *values, uint32_t n);
+WEUDEF uint32_t weu_hashtable_getInts(weu_hashTable *table, const uint64_t *keys, uint32_t n, void **out);
+WEUDEF uint32_t weu_hashtable_addInts(weu_hashTable *table, const uint64_t *keys, void *const *values, uint32_t n);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
 //  INDEX
+//  Index is position of item in entry array, items keep their index until insertion compacts removed entries.
+//  getUsableIndex returns index setDataAtIndex appends next item at.
 
 WEUDEF int weu_hashtable_getUsableIndex(weu_hashTable *table, weu_string *key, bool freeKeyOnDone);
-WEUDEF void weu_hashtable_setDataAtIndex(weu_hashTable *table, unsigned int index, weu_string *key, void *data, bool freeKeyOnDone);
+//  Key already stored at index only gets its value replaced. Returns WEU_HASH_EXISTS when key is
+//  stored at other index, table is left untouched then and data stays owned by caller, as it does
+//  for any status other than WEU_HASH_OK.
+WEUDEF weu_hashStatus weu_hashtable_setDataAtIndex(weu_hashTable *table, unsigned int index, weu_string *key, void *data, bool freeKeyOnDone);
 WEUDEF void weu_hashtable_removeItemAtIndex(weu_hashTable *table, unsigned int index);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  GET KEY
 
-WEUDEF weu_string* weu_hashtable_getKeyByIndex(weu_hashTable *table, unsigned int index);
+//  Returns slice of key stored in table arena, length 0 and text NULL if entry is removed.
+//  Slice is valid until next insertion into table.
+WEUDEF weu_string weu_hashtable_getKeyByIndex(weu_hashTable *table, unsigned int index);
 WEUDEF int weu_hashtable_getKeyIndex(weu_hashTable *table, weu_string *key, bool freeKeyOnDone);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ITERATION
+//  Items are visited in insertion order, walk costs O(count) and never touches empty slots.
+//  Start with iterator 0, returns false after last item. Index of returned item is iterator - 1.
+//  Removing items while iterating is allowed, insertion may compact entries and invalidate iterator.
+
+WEUDEF bool weu_hashtable_next(weu_hashTable *table, uint32_t *iterator, weu_string *keyOut, void **valueOut);
+WEUDEF bool weu_hashtable_nextInt(weu_hashTable *table, uint32_t *iterator, uint64_t *keyOut, void **valueOut);
+#ifdef WEU_HASHTABLE_STATS
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  STATS
+//  Only with WEU_HASHTABLE_STATS defined. Probe lengths are measured by walking slot arrays,
+//  long probes with low load point to clustered hashes, long probes with high load to saturation.
+
+WEUDEF void weu_hashtable_stats(const weu_hashTable *table, weu_hashTableStats *out);
+WEUDEF void weu_hashtable_resetStats(weu_hashTable *table);
+#endif
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FREEZE
+//  Frozen table is indexed by minimal perfect hash built with hash and displace, CHD/PTHash style.
+//  Keys are split to buckets, every bucket gets 16 bit pilot that displaces its keys to unused entries.
+//  Lookup hashes key once and compares single entry, key either matches it or is missing.
+//  No empty slots, pilots and remap cost under 3 bits per key over entries and key bytes.
+
+//  Consumes table, its values and datafreefun move to frozen table and *handle is set to NULL.
+//  Returns NULL and leaves table untouched if no pilots were found in WEU_HASHTABLE_FROZEN_ATTEMPTS.
+//  Distinct keys of equal hash can never be separated, retries hash them again with wyhash and
+//  new seed, so only CUSTOM hashers returning 32 bit hashes start to fail at about hundred
+//  thousand keys.
+WEUDEF weu_frozenHashTable *weu_hashtable_freeze(weu_hashTable **handle);
+WEUDEF void weu_frozenHashTable_free(weu_frozenHashTable **handle);
+
+WEUDEF weu_hashStatus weu_frozenHashTable_getText(const weu_frozenHashTable *table, const char *key, uint32_t keyLen, void **valueOut);
+WEUDEF weu_hashStatus weu_frozenHashTable_getSlice(const weu_frozenHashTable *table, weu_string key, void **valueOut);
+WEUDEF weu_hashStatus weu_frozenHashTable_getInt(const weu_frozenHashTable *table, uint64_t key, void **valueOut);
+WEUDEF weu_hashStatus weu_frozenHashTable_getKey(const weu_frozenHashTable *table, const void *key, void **valueOut);
 
 #ifdef WEU_IMPLEMENTATION
+
+#include <string.h>
+#include <time.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTERNAL
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WEU_HASHGROUP_SSE2
+#endif
+
+#define _WEU_CTRL_EMPTY     0x80
+#define _WEU_CTRL_DELETED   0xfe
+#define _WEU_GROUP_WIDTH    16
+
+static inline uint32_t _weu_hashtable_ctz(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#else
+    uint32_t out = 0;
+    while (!(x & 1)) { x >>= 1; ++out; }
+    return out;
+#endif
+}
+//  Bit per slot of group whose control byte equals c.
+static inline uint32_t _weu_hashgroup_match(const uint8_t *group, uint8_t c) {
+#ifdef WEU_HASHGROUP_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)c)));
+#else
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < _WEU_GROUP_WIDTH; i++) out |= (uint32_t)(group[i] == c) << i;
+    return out;
+#endif
+}
+//  Bit per slot of group that is empty or deleted.
+static inline uint32_t _weu_hashgroup_matchFree(const uint8_t *group) {
+#ifdef WEU_HASHGROUP_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < _WEU_GROUP_WIDTH; i++) out |= (uint32_t)(group[i] >> 7) << i;
+    return out;
+#endif
+}
+#if defined(__GNUC__) || defined(__clang__)
+#define _WEU_PREFETCH(ADDR) __builtin_prefetch(ADDR)
+#else
+#define _WEU_PREFETCH(ADDR) ((void)(ADDR))
+#endif
+//  Returns incremented value, other compilers fall back to plain increment and must not race.
+#if defined(__GNUC__) || defined(__clang__)
+#define _WEU_ATOMIC_INCREMENT(PTR) __atomic_add_fetch(PTR, 1, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define _WEU_ATOMIC_INCREMENT(PTR) (uint64_t)_InterlockedIncrement64((volatile long long*)(PTR))
+#else
+#define _WEU_ATOMIC_INCREMENT(PTR) (++*(PTR))
+#endif
+
+static inline uint8_t _weu_hashtable_h2(uint64_t hash) {
+    return hash & 0x7f;
+}
+static inline uint32_t _weu_hashtable_h1(uint64_t hash) {
+    return (uint32_t)hash >> 7;
+}
+
+static inline bool _weu_hashtable_intKeyed(const weu_hashTable *table) {
+    return table->keyMode == WEU_HASHKEY_INT32 || table->keyMode == WEU_HASHKEY_INT64;
+}
+static inline bool _weu_hashtable_inUse(const weu_hashItem *item) {
+    return item->keyLength < WEU_HASHITEM_DELETED;
+}
+static inline bool _weu_hashtable_slotInUse(const weu_hashSlot *slot) {
+    return slot->entry < WEU_HASHITEM_DELETED;
+}
+//  Compares key bytes only when cached hash and length match.
+//  Integer keys are mixed with bijective function, equal hash means equal key.
+static inline bool _weu_hashtable_keyEquals(const weu_hashTable *table, const weu_hashItem *item, const char *key, uint32_t keyLen, uint64_t hash) {
+    if (item->hash != hash || item->keyLength != keyLen) return false;
+    switch (table->keyMode) {
+    case WEU_HASHKEY_INT32:
+    case WEU_HASHKEY_INT64:     return true;
+    case WEU_HASHKEY_CUSTOM:    return table->keyCompare(table->keys + item->keyOffset, key, keyLen);
+    default:                    return memcmp(table->keys + item->keyOffset, key, keyLen) == 0;
+    }
+}
+//  Slot keeps low 32 hash bits, probes touch entry only when they match.
+static inline bool _weu_hashtable_slotEquals(const weu_hashTable *table, const weu_hashSlot *slot, const char *key, uint32_t keyLen, uint64_t hash) {
+    return slot->hash == (uint32_t)hash && _weu_hashtable_keyEquals(table, &table->data[slot->entry], key, keyLen, hash);
+}
+static inline uint32_t _weu_hashtable_maxLoad(weu_hashEngine engine) {
+    return engine == WEU_HASHENGINE_GROUP ? WEU_HASHTABLE_GROUP_MAX_LOAD : WEU_HASHTABLE_MAX_LOAD;
+}
+//  Smallest power of two slot count holding count items under maximum load.
+static uint32_t _weu_hashtable_capacityFor(weu_hashEngine engine, uint32_t count) {
+    uint32_t maxLoad = _weu_hashtable_maxLoad(engine);
+    uint64_t required = ((uint64_t)count * 100 + maxLoad - 1) / maxLoad;
+    uint32_t out = MIN_TABLE_SIZE;
+    while (out < required && out < MAX_TABLE_SIZE) out <<= 1;
+    return out;
+}
+static weu_hashSlot *_weu_hashtable_allocSlots(uint32_t length, uint8_t **ctrlOut, weu_hashEngine engine) {
+    weu_hashSlot *out = (weu_hashSlot*)malloc(sizeof(weu_hashSlot) * length);
+    for (uint32_t i = 0; i < length; i++) out[i].entry = WEU_HASHITEM_EMPTY;
+    *ctrlOut = NULL;
+    if (engine == WEU_HASHENGINE_GROUP) {
+        *ctrlOut = (uint8_t*)malloc(length);
+        memset(*ctrlOut, _WEU_CTRL_EMPTY, length);
+    }
+    return out;
+}
+//  Returns slot index of key in slot array or WEU_INDEX_INVALID.
+//  ctrl set - probes groups of control bytes, touches slot only on 7 bit hash fragment match.
+static uint32_t _weu_hashtable_findIn(const weu_hashTable *table, const weu_hashSlot *slots, const uint8_t *ctrl, uint32_t length, const char *key, uint32_t keyLen, uint64_t hash) {
+    uint32_t mask = length - 1;
+    if (ctrl != NULL) {
+        uint32_t groupMask = mask >> 4;
+        uint32_t group = _weu_hashtable_h1(hash) & groupMask;
+        uint8_t h2 = _weu_hashtable_h2(hash);
+        for (uint32_t i = 0; i <= groupMask; i++) {
+            const uint8_t *groupCtrl = ctrl + (group << 4);
+            for (uint32_t m = _weu_hashgroup_match(groupCtrl, h2); m; m &= m - 1) {
+                uint32_t position = (group << 4) + _weu_hashtable_ctz(m);
+                if (_weu_hashtable_slotEquals(table, &slots[position], key, keyLen, hash)) return position;
+            }
+            if (_weu_hashgroup_match(groupCtrl, _WEU_CTRL_EMPTY)) break;
+            group = (group + i + 1) & groupMask;
+        }
+        return WEU_INDEX_INVALID;
+    }
+    uint32_t position = hash & mask;
+    for (uint32_t i = 0; i < length; i++) {
+        const weu_hashSlot *slot = &slots[position];
+        if (slot->entry == WEU_HASHITEM_EMPTY) break;
+        if (slot->entry != WEU_HASHITEM_DELETED && _weu_hashtable_slotEquals(table, slot, key, keyLen, hash)) return position;
+        position = (position + 1) & mask;
+    }
+    return WEU_INDEX_INVALID;
+}
+//  Returns slot index pointing to entry, entry must be reachable from slot array.
+static uint32_t _weu_hashtable_findEntry(const weu_hashSlot *slots, const uint8_t *ctrl, uint32_t length, uint32_t entry, uint64_t hash) {
+    uint32_t mask = length - 1;
+    if (ctrl != NULL) {
+        uint32_t groupMask = mask >> 4;
+        uint32_t group = _weu_hashtable_h1(hash) & groupMask;
+        uint8_t h2 = _weu_hashtable_h2(hash);
+        for (uint32_t i = 0; i <= groupMask; i++) {
+            const uint8_t *groupCtrl = ctrl + (group << 4);
+            for (uint32_t m = _weu_hashgroup_match(groupCtrl, h2); m; m &= m - 1) {
+                uint32_t position = (group << 4) + _weu_hashtable_ctz(m);
+                if (slots[position].entry == entry) return position;
+            }
+            if (_weu_hashgroup_match(groupCtrl, _WEU_CTRL_EMPTY)) break;
+            group = (group + i + 1) & groupMask;
+        }
+        return WEU_INDEX_INVALID;
+    }
+    uint32_t position = hash & mask;
+    for (uint32_t i = 0; i < length; i++) {
+        if (slots[position].entry == WEU_HASHITEM_EMPTY) break;
+        if (slots[position].entry == entry) return position;
+        position = (position + 1) & mask;
+    }
+    return WEU_INDEX_INVALID;
+}
+//  Returns first empty or deleted slot index for hash.
+static uint32_t _weu_hashtable_findFree(const weu_hashSlot *slots, const uint8_t *ctrl, uint32_t length, uint64_t hash) {
+    uint32_t mask = length - 1;
+    if (ctrl != NULL) {
+        uint32_t groupMask = mask >> 4;
+        uint32_t group = _weu_hashtable_h1(hash) & groupMask;
+        for (uint32_t i = 0; ; i++) {
+            uint32_t m = _weu_hashgroup_matchFree(ctrl + (group << 4));
+            if (m) return (group << 4) + _weu_hashtable_ctz(m);
+            group = (group + i + 1) & groupMask;
+        }
+    }
+    uint32_t position = hash & mask;
+    while (_weu_hashtable_slotInUse(&slots[position])) position = (position + 1) & mask;
+    return position;
+}
+//  Returns slot index key can be inserted at in current slot array, WEU_INDEX_INVALID if key is present.
+static uint32_t _weu_hashtable_findUsable(const weu_hashTable *table, const char *key, uint32_t keyLen, uint64_t hash) {
+    uint32_t mask = table->length - 1;
+    uint32_t usable = WEU_INDEX_INVALID;
+    if (table->ctrl != NULL) {
+        uint32_t groupMask = mask >> 4;
+        uint32_t group = _weu_hashtable_h1(hash) & groupMask;
+        uint8_t h2 = _weu_hashtable_h2(hash);
+        for (uint32_t i = 0; i <= groupMask; i++) {
+            const uint8_t *groupCtrl = table->ctrl + (group << 4);
+            for (uint32_t m = _weu_hashgroup_match(groupCtrl, h2); m; m &= m - 1) {
+                uint32_t position = (group << 4) + _weu_hashtable_ctz(m);
+                if (_weu_hashtable_slotEquals(table, &table->slots[position], key, keyLen, hash)) return WEU_INDEX_INVALID;
+            }
+            uint32_t freeMask = _weu_hashgroup_matchFree(groupCtrl);
+            if (freeMask && usable == WEU_INDEX_INVALID) usable = (group << 4) + _weu_hashtable_ctz(freeMask);
+            if (_weu_hashgroup_match(groupCtrl, _WEU_CTRL_EMPTY)) break;
+            group = (group + i + 1) & groupMask;
+        }
+        return usable;
+    }
+    uint32_t position = hash & mask;
+    for (uint32_t i = 0; i < table->length; i++) {
+        const weu_hashSlot *slot = &table->slots[position];
+        if (slot->entry == WEU_HASHITEM_EMPTY) return usable != WEU_INDEX_INVALID ? usable : position;
+        if (slot->entry == WEU_HASHITEM_DELETED) { if (usable == WEU_INDEX_INVALID) usable = position; }
+        else if (_weu_hashtable_slotEquals(table, slot, key, keyLen, hash)) return WEU_INDEX_INVALID;
+        position = (position + 1) & mask;
+    }
+    return usable;
+}
+//  Appends null terminated key bytes to arena, returns offset. Integer keys are not stored.
+//  Key offsets are 32 bit, arena never grows past UINT32_MAX bytes.
+static inline bool _weu_hashtable_keyFits(const weu_hashTable *table, uint32_t keyLen) {
+    return _weu_hashtable_intKeyed(table) || (uint64_t)table->keysLength + keyLen + 1 <= UINT32_MAX;
+}
+//  Caller checks _weu_hashtable_keyFits first.
+static uint32_t _weu_hashtable_storeKey(weu_hashTable *table, const char *key, uint32_t keyLen) {
+    if (_weu_hashtable_intKeyed(table)) return 0;
+    uint64_t required = (uint64_t)table->keysLength + keyLen + 1;
+    if (required > table->keysCapacity) {
+        uint64_t capacity = table->keysCapacity > MIN_KEYS_CAPACITY ? table->keysCapacity : MIN_KEYS_CAPACITY;
+        while (capacity < required) capacity *= 2;
+        if (capacity > UINT32_MAX) capacity = UINT32_MAX;
+        table->keys = (char*)realloc(table->keys, (size_t)capacity);
+        table->keysCapacity = (uint32_t)capacity;
+    }
+    uint32_t offset = table->keysLength;
+    memcpy(table->keys + offset, key, keyLen);
+    table->keys[offset + keyLen] = '\0';
+    table->keysLength = (uint32_t)required;
+    return offset;
+}
+//  Points free slot of current slot array to entry.
+static void _weu_hashtable_fillSlot(weu_hashTable *table, uint32_t position, uint32_t entry, uint64_t hash) {
+    weu_hashSlot *slot = &table->slots[position];
+    if (slot->entry == WEU_HASHITEM_DELETED) --table->deleted;
+    slot->entry = entry;
+    slot->hash  = (uint32_t)hash;
+    if (table->ctrl != NULL) table->ctrl[position] = _weu_hashtable_h2(hash);
+}
+//  Moves up to steps old slots to current slot array, frees old slot array when done.
+//  Entries stay in place, only slots pointing to them move.
+static void _weu_hashtable_rehashStep(weu_hashTable *table, uint32_t steps) {
+    if (table->oldSlots == NULL) return;
+    uint32_t end = table->oldLength - table->rehashPos > steps ? table->rehashPos + steps : table->oldLength;
+    for (; table->rehashPos < end; table->rehashPos++) {
+        weu_hashSlot *slot = &table->oldSlots[table->rehashPos];
+        if (!_weu_hashtable_slotInUse(slot)) continue;
+        uint64_t hash = table->data[slot->entry].hash;
+        _weu_hashtable_fillSlot(table, _weu_hashtable_findFree(table->slots, table->ctrl, table->length, hash), slot->entry, hash);
+        //  Keep probe chains of not yet moved slots intact
+        slot->entry = WEU_HASHITEM_DELETED;
+        if (table->oldCtrl != NULL) table->oldCtrl[table->rehashPos] = _WEU_CTRL_DELETED;
+    }
+    if (table->rehashPos == table->oldLength) {
+        free(table->oldSlots);
+        free(table->oldCtrl);
+        table->oldSlots     = NULL;
+        table->oldCtrl      = NULL;
+        table->oldLength    = 0;
+        table->rehashPos    = 0;
+    }
+}
+static inline void _weu_hashtable_rehashFinish(weu_hashTable *table) {
+    _weu_hashtable_rehashStep(table, WEU_INDEX_INVALID);
+}
+//  Starts moving slots to new slot array of length.
+static void _weu_hashtable_resize(weu_hashTable *table, uint32_t length) {
+    _weu_hashtable_rehashFinish(table);
+    table->oldSlots     = table->slots;
+    table->oldCtrl      = table->ctrl;
+    table->oldLength    = table->length;
+    table->rehashPos    = 0;
+    table->slots        = _weu_hashtable_allocSlots(length, &table->ctrl, table->engine);
+    table->length       = length;
+    table->deleted      = 0;
+}
+//  Drops removed entries and their key bytes, then rebuilds slot array of length at once.
+//  Entry indexes of live items change.
+static void _weu_hashtable_compact(weu_hashTable *table, uint32_t length) {
+    _weu_hashtable_rehashFinish(table);
+    char *keys = NULL;
+    uint32_t keysCapacity = 0;
+    if (!_weu_hashtable_intKeyed(table)) {
+        keysCapacity = table->keysLength > MIN_KEYS_CAPACITY ? table->keysLength : MIN_KEYS_CAPACITY;
+        keys = (char*)malloc(keysCapacity);
+    }
+    uint32_t keysLength = 0, dataLength = 0;
+    for (uint32_t i = 0; i < table->dataLength; i++) {
+        weu_hashItem item = table->data[i];
+        if (!_weu_hashtable_inUse(&item)) continue;
+        if (keys != NULL) {
+            memcpy(keys + keysLength, table->keys + item.keyOffset, item.keyLength + 1);
+            item.keyOffset = keysLength;
+            keysLength += item.keyLength + 1;
+        }
+        table->data[dataLength++] = item;
+    }
+    if (keys != NULL) {
+        free(table->keys);
+        table->keys         = keys;
+        table->keysLength   = keysLength;
+        table->keysCapacity = keysCapacity;
+    }
+    table->dataLength = dataLength;
+    free(table->slots);
+    free(table->ctrl);
+    table->slots    = _weu_hashtable_allocSlots(length, &table->ctrl, table->engine);
+    table->length   = length;
+    table->deleted  = 0;
+    for (uint32_t i = 0; i < dataLength; i++) {
+        uint64_t hash = table->data[i].hash;
+        _weu_hashtable_fillSlot(table, _weu_hashtable_findFree(table->slots, table->ctrl, length, hash), i, hash);
+    }
+}
+//  Makes room for one more entry and its key bytes before slot array is searched.
+//  Compacts when quarter of entries or half of key arena belong to removed items, grows otherwise.
+static void _weu_hashtable_reserveEntry(weu_hashTable *table, uint32_t keyLen) {
+    bool keysFull = !_weu_hashtable_intKeyed(table) && (uint64_t)table->keysLength + keyLen + 1 > table->keysCapacity;
+    if (table->dataLength < table->dataCapacity && !keysFull) return;
+    uint32_t removed = table->dataLength - table->count;
+    bool compact = removed > 0 && removed >= table->dataLength >> 2;
+    if (!compact && keysFull && removed > 0) {
+        uint64_t used = 0;
+        for (uint32_t i = 0; i < table->dataLength; i++) {
+            if (_weu_hashtable_inUse(&table->data[i])) used += table->data[i].keyLength + 1;
+        }
+        compact = used <= table->keysLength >> 1 || !_weu_hashtable_keyFits(table, keyLen);
+    }
+    if (compact) _weu_hashtable_compact(table, table->length);
+    if (table->dataLength < table->dataCapacity) return;
+    table->dataCapacity = table->dataCapacity > 0 ? table->dataCapacity * 2 : MIN_TABLE_SIZE;
+    table->data = (weu_hashItem*)realloc(table->data, sizeof(weu_hashItem) * table->dataCapacity);
+}
+static inline bool _weu_hashtable_needsGrow(const weu_hashTable *table) {
+    return (uint64_t)(table->count + table->deleted + 1) * 100 > (uint64_t)table->length * _weu_hashtable_maxLoad(table->engine);
+}
+//  Doubles slot array when full of used items, keeps size when mostly deleted slots are reclaimed.
+static inline void _weu_hashtable_grow(weu_hashTable *table) {
+    uint32_t length = _weu_hashtable_capacityFor(table->engine, table->count + (table->count >> 2) + 1);
+    _weu_hashtable_resize(table, length > table->length ? length : table->length);
+}
+//  Returns entry index of key or WEU_INDEX_INVALID.
+//  slotOut and inOldOut, when not NULL, receive slot index of key and whether it is in old slot array.
+static uint32_t _weu_hashtable_locate(weu_hashTable *table, const char *key, uint32_t keyLen, uint64_t hash, uint32_t *slotOut, bool *inOldOut) {
+    _weu_hashtable_rehashStep(table, WEU_HASHTABLE_REHASH_STEP);
+    bool inOld = false;
+    uint32_t position = _weu_hashtable_findIn(table, table->slots, table->ctrl, table->length, key, keyLen, hash);
+    if (position == WEU_INDEX_INVALID && table->oldSlots != NULL) {
+        position = _weu_hashtable_findIn(table, table->oldSlots, table->oldCtrl, table->oldLength, key, keyLen, hash);
+        inOld = true;
+    }
+    if (slotOut != NULL) *slotOut = position;
+    if (inOldOut != NULL) *inOldOut = inOld;
+    if (position == WEU_INDEX_INVALID) {
+        _WEU_HASHTABLE_COUNT(table, misses);
+        return WEU_INDEX_INVALID;
+    }
+    _WEU_HASHTABLE_COUNT(table, hits);
+    return inOld ? table->oldSlots[position].entry : table->slots[position].entry;
+}
+//  Stores key at entry index, WEU_INDEX_INVALID appends new entry. Returns WEU_HASH_EXISTS if key is
+//  already present, WEU_HASH_INVALID if key arena is full. Entry index other than WEU_INDEX_INVALID
+//  must be a removed entry.
+static weu_hashStatus _weu_hashtable_insertAt(weu_hashTable *table, uint32_t entry, const char *key, uint32_t keyLen, uint64_t hash, void *value) {
+    if (entry == WEU_INDEX_INVALID) _weu_hashtable_reserveEntry(table, keyLen);
+    if (!_weu_hashtable_keyFits(table, keyLen)) {
+        _WEU_HASHTABLE_COUNT(table, failedInserts);
+        return WEU_HASH_INVALID;
+    }
+    _weu_hashtable_rehashStep(table, WEU_HASHTABLE_REHASH_STEP);
+    uint32_t position = WEU_INDEX_INVALID;
+    if (table->oldSlots == NULL || _weu_hashtable_findIn(table, table->oldSlots, table->oldCtrl, table->oldLength, key, keyLen, hash) == WEU_INDEX_INVALID) {
+        position = _weu_hashtable_findUsable(table, key, keyLen, hash);
+    }
+    if (position == WEU_INDEX_INVALID) {
+        _WEU_HASHTABLE_COUNT(table, failedInserts);
+        return WEU_HASH_EXISTS;
+    }
+    if (entry == WEU_INDEX_INVALID) entry = table->dataLength;
+    if (table->slots[position].entry == WEU_HASHITEM_EMPTY && _weu_hashtable_needsGrow(table)) {
+        _weu_hashtable_grow(table);
+        _weu_hashtable_rehashStep(table, WEU_HASHTABLE_REHASH_STEP);
+        position = _weu_hashtable_findFree(table->slots, table->ctrl, table->length, hash);
+    }
+    weu_hashItem *item = &table->data[entry];
+    item->hash      = hash;
+    item->keyOffset = _weu_hashtable_storeKey(table, key, keyLen);
+    item->keyLength = keyLen;
+    item->value     = value;
+    if (entry >= table->dataLength) table->dataLength = entry + 1;
+    _weu_hashtable_fillSlot(table, position, entry, hash);
+    ++table->count;
+    _WEU_HASHTABLE_COUNT(table, inserts);
+    return WEU_HASH_OK;
+}
+static inline weu_hashStatus _weu_hashtable_insert(weu_hashTable *table, const char *key, uint32_t keyLen, uint64_t hash, void *value) {
+    return _weu_hashtable_insertAt(table, WEU_INDEX_INVALID, key, keyLen, hash, value);
+}
+//  Frees slot of current or old slot array and its entry, trailing removed entries are dropped.
+//  GROUP engine marks slot empty when its group already has empty slot, probing stops at that group anyway.
+static void _weu_hashtable_removeAt(weu_hashTable *table, bool inOld, uint32_t position) {
+    weu_hashSlot *slots = inOld ? table->oldSlots : table->slots;
+    uint8_t *ctrl = inOld ? table->oldCtrl : table->ctrl;
+    uint32_t entry = slots[position].entry;
+    uint32_t state = WEU_HASHITEM_DELETED;
+    if (ctrl != NULL) {
+        bool groupHasEmpty = _weu_hashgroup_match(ctrl + (position & ~(uint32_t)(_WEU_GROUP_WIDTH - 1)), _WEU_CTRL_EMPTY) != 0;
+        if (groupHasEmpty) state = WEU_HASHITEM_EMPTY;
+        ctrl[position] = groupHasEmpty ? _WEU_CTRL_EMPTY : _WEU_CTRL_DELETED;
+    }
+    if (!inOld && state == WEU_HASHITEM_DELETED) ++table->deleted;
+    slots[position].entry = state;
+
+    weu_hashItem *item = &table->data[entry];
+    if (table->d != NULL) table->d(&item->value);
+    item->keyLength = WEU_HASHITEM_DELETED;
+    item->value     = NULL;
+    while (table->dataLength > 0 && !_weu_hashtable_inUse(&table->data[table->dataLength - 1])) --table->dataLength;
+    if (--table->count == 0) {
+        table->dataLength = 0;
+        table->keysLength = 0;
+    }
+}
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  HASH
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -74,164 +663,863 @@ unsigned int weu_hash_FNV(const char *str, int strlen) {
 unsigned int weu_hash_strFNV(weu_string *str) {
     return weu_hash_FNV(str->text, str->length);
 }
+
+uint64_t weu_hash_FNVSeeded(const void *data, uint32_t length, uint64_t seed) {
+    const uint8_t *p = (const uint8_t*)data;
+    uint64_t hash = FNV_OFF_BASIS_64 ^ seed;
+    for (uint32_t i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME_64;
+    }
+    return hash;
+}
+
+static inline void _weu_hash_mul128(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+static inline uint64_t _weu_hash_mix(uint64_t a, uint64_t b) {
+    _weu_hash_mul128(&a, &b);
+    return a ^ b;
+}
+static inline uint64_t _weu_hash_read8(const uint8_t *p) { uint64_t v; memcpy(&v, p, 8); return v; }
+static inline uint64_t _weu_hash_read4(const uint8_t *p) { uint32_t v; memcpy(&v, p, 4); return v; }
+//  splitmix64 finalizer
+static inline uint64_t _weu_hash_fmix64(uint64_t x) {
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t weu_hash_wy(const void *data, uint32_t length, uint64_t seed) {
+    static const uint64_t s0 = 0xa0761d6478bd642fULL, s1 = 0xe7037ed1a0b428dbULL;
+    static const uint64_t s2 = 0x8ebc6af09c88c6e3ULL, s3 = 0x589965cc75374cc3ULL;
+    const uint8_t *p = (const uint8_t*)data;
+    uint64_t a, b;
+    seed ^= _weu_hash_mix(seed ^ s0, s1);
+    if (length <= 16) {
+        if (length >= 4) {
+            uint32_t shift = (length >> 3) << 2;
+            a = (_weu_hash_read4(p) << 32) | _weu_hash_read4(p + shift);
+            b = (_weu_hash_read4(p + length - 4) << 32) | _weu_hash_read4(p + length - 4 - shift);
+        }
+        else if (length > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+            b = 0;
+        }
+        else a = b = 0;
+    }
+    else {
+        uint32_t i = length;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = _weu_hash_mix(_weu_hash_read8(p) ^ s1, _weu_hash_read8(p + 8) ^ seed);
+                see1 = _weu_hash_mix(_weu_hash_read8(p + 16) ^ s2, _weu_hash_read8(p + 24) ^ see1);
+                see2 = _weu_hash_mix(_weu_hash_read8(p + 32) ^ s3, _weu_hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = _weu_hash_mix(_weu_hash_read8(p) ^ s1, _weu_hash_read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = _weu_hash_read8(p + i - 16);
+        b = _weu_hash_read8(p + i - 8);
+    }
+    a ^= s1;
+    b ^= seed;
+    _weu_hash_mul128(&a, &b);
+    return _weu_hash_mix(a ^ s0 ^ length, b ^ s1);
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+#define WEU_HASH_CRC32C_HW
+__attribute__((target("sse4.2")))
+static uint32_t _weu_hash_crc32cHW(const uint8_t *p, uint32_t length, uint32_t crc) {
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; length >= 8; length -= 8, p += 8) crc64 = _mm_crc32_u64(crc64, _weu_hash_read8(p));
+    crc = (uint32_t)crc64;
+#endif
+    for (; length >= 4; length -= 4, p += 4) crc = _mm_crc32_u32(crc, (uint32_t)_weu_hash_read4(p));
+    for (; length > 0; length--, p++) crc = _mm_crc32_u8(crc, *p);
+    return crc;
+}
+#endif
+//  Reflected Castagnoli polynomial 0x82f63b78, constant so threads never race on building it.
+static const uint32_t _weu_hash_crc32cTable[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c, 0x26a1e7e8, 0xd4ca64eb,
+    0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b, 0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24,
+    0x105ec76f, 0xe235446c, 0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc, 0xbc267848, 0x4e4dfb4b,
+    0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a, 0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35,
+    0xaa64d611, 0x580f5512, 0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad, 0x1642ae59, 0xe4292d5a,
+    0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a, 0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595,
+    0x417b1dbc, 0xb3109ebf, 0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f, 0xed03a29b, 0x1f682198,
+    0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927, 0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38,
+    0xdbfc821c, 0x2997011f, 0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e, 0x4767748a, 0xb50cf789,
+    0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859, 0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46,
+    0x7198540d, 0x83f3d70e, 0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de, 0xdde0eb2a, 0x2f8b6829,
+    0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c, 0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93,
+    0x082f63b7, 0xfa44e0b4, 0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b, 0xb4091bff, 0x466298fc,
+    0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c, 0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033,
+    0xa24bb5a6, 0x502036a5, 0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975, 0x0e330a81, 0xfc588982,
+    0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d, 0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622,
+    0x38cc2a06, 0xcaa7a905, 0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8, 0xe52cc12c, 0x1747422f,
+    0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff, 0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0,
+    0xd3d3e1ab, 0x21b862a8, 0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78, 0x7fab5e8c, 0x8dc0dd8f,
+    0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee, 0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1,
+    0x69e9f0d5, 0x9b8273d6, 0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69, 0xd5cf889d, 0x27a40b9e,
+    0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e, 0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+static uint32_t _weu_hash_crc32cSW(const uint8_t *p, uint32_t length, uint32_t crc) {
+    for (uint32_t i = 0; i < length; i++) crc = _weu_hash_crc32cTable[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+uint64_t weu_hash_crc32c(const void *data, uint32_t length, uint64_t seed) {
+    const uint8_t *p = (const uint8_t*)data;
+    uint32_t crc;
+#ifdef WEU_HASH_CRC32C_HW
+    //  Threads racing on first call store same answer, atomic access keeps that defined
+    static int hwCached = -1;
+    int hwSupport = __atomic_load_n(&hwCached, __ATOMIC_RELAXED);
+    if (hwSupport < 0) {
+        hwSupport = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+        __atomic_store_n(&hwCached, hwSupport, __ATOMIC_RELAXED);
+    }
+    if (hwSupport)  crc = _weu_hash_crc32cHW(p, length, ~(uint32_t)seed);
+    else            crc = _weu_hash_crc32cSW(p, length, ~(uint32_t)seed);
+#else
+    crc = _weu_hash_crc32cSW(p, length, ~(uint32_t)seed);
+#endif
+    //  Spread 32 bits of crc over whole hash, probing uses both low and high bits
+    return _weu_hash_fmix64((((uint64_t)crc << 32) | length) ^ seed);
+}
+
+uint64_t weu_hash(weu_hashFunction fun, const void *data, uint32_t length, uint64_t seed) {
+    switch (fun) {
+    case WEU_HASHFUN_CRC32C:    return weu_hash_crc32c(data, length, seed);
+    case WEU_HASHFUN_FNV:       return weu_hash_FNVSeeded(data, length, seed);
+    default:                    return weu_hash_wy(data, length, seed);
+    }
+}
+uint64_t weu_hash_int(uint64_t key, uint64_t seed) {
+    uint64_t x = key ^ seed;
+    x ^= x >> 33; x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL;
+    return x ^ (x >> 33);
+}
+//  Inverse of weu_hash_int, integer keys are only stored as their hash.
+static inline uint64_t _weu_hash_intInverse(uint64_t hash, uint64_t seed) {
+    uint64_t x = hash;
+    x ^= x >> 33; x *= 0x9cb4b2f8129337dbULL;
+    x ^= x >> 33; x *= 0x4f74430c22a54005ULL;
+    return (x ^ (x >> 33)) ^ seed;
+}
+uint64_t weu_hash_randomSeed(void) {
+    static uint64_t counter = 0;
+    uint64_t entropy = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32) ^ (uint64_t)(uintptr_t)&counter;
+    entropy ^= (uint64_t)(uintptr_t)&entropy << 16;
+    entropy += _WEU_ATOMIC_INCREMENT(&counter) * 0x9e3779b97f4a7c15ULL;
+    uint64_t out = _weu_hash_fmix64(entropy);
+    return out != 0 ? out : 1;
+}
+static inline uint64_t _weu_hashtable_hash(const weu_hashTable *table, const char *key, uint32_t keyLen) {
+    if (table->keyMode == WEU_HASHKEY_CUSTOM) return table->keyHash(key, keyLen, table->seed);
+    return weu_hash(table->hashFun, key, keyLen, table->seed);
+}
+//  Text, slice and weu_string keys are valid for TEXT and CUSTOM tables, POD when length matches key size.
+static inline bool _weu_hashtable_acceptsBytes(const weu_hashTable *table, uint32_t keyLen) {
+    if (_weu_hashtable_intKeyed(table)) return false;
+    return table->keyMode != WEU_HASHKEY_POD || keyLen == table->keySize;
+}
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  ALLOCATION
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
 weu_hashTable *weu_hashtable_new(int size, datafreefun d) {
-    size = size > MIN_TABLE_SIZE ? size : MIN_TABLE_SIZE;
-    weu_hashTable *out = (weu_hashTable*)malloc(sizeof(weu_hashTable));
-    out->length = size;
-    out->data = (weu_hashItem*)malloc(sizeof(weu_hashItem) * size);
-    if (d != NULL) out->d = d; else out->d = NULL;
-    for (int i = 0; i < size; i++) {
-        out->data[i].inUse = 0;
-        out->data[i].value = NULL;
-        out->data[i].key = weu_string_new("");
-    }
+    return weu_hashtable_newDesc(&(weu_hashTableDesc){.size = size > 0 ? size : 0, .d = d});
+}
+weu_hashTable *weu_hashtable_newDesc(const weu_hashTableDesc *desc) {
+    uint32_t length = MIN_TABLE_SIZE;
+    while (length < desc->size && length < MAX_TABLE_SIZE) length <<= 1;
+    weu_hashTable *out = (weu_hashTable*)calloc(1, sizeof(weu_hashTable));
+    out->engine         = desc->engine;
+    out->hashFun        = desc->hash;
+    out->keyMode        = desc->keyMode;
+    out->keySize        = desc->keyMode == WEU_HASHKEY_INT32 ? sizeof(uint32_t) : desc->keyMode == WEU_HASHKEY_INT64 ? sizeof(uint64_t) : desc->keySize;
+    out->keyHash        = desc->keyHash;
+    out->keyCompare     = desc->keyCompare;
+    out->seed           = desc->seed != 0 ? desc->seed : weu_hash_randomSeed();
+    out->length         = length;
+    out->slots          = _weu_hashtable_allocSlots(length, &out->ctrl, out->engine);
+    out->d              = desc->d;
     return out;
 }
 void weu_hashtable_free(weu_hashTable **handle) {
     weu_hashTable *table = (*handle);
-    for (unsigned int i = 0; i < table->length; i++) {
-        weu_string_free(&table->data[i].key);
-        if (table->d != NULL) table->d(&table->data[i].value);
+    if (table == NULL) return;
+    if (table->d != NULL) {
+        for (uint32_t i = 0; i < table->dataLength; i++) {
+            if (_weu_hashtable_inUse(&table->data[i])) table->d(&table->data[i].value);
+        }
     }
-    free((*handle)->data);
-    free(*handle);
+    free(table->oldSlots);
+    free(table->oldCtrl);
+    free(table->keys);
+    free(table->slots);
+    free(table->ctrl);
+    free(table->data);
+    free(table);
     *handle = NULL;
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CAPACITY
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void weu_hashtable_reserve(weu_hashTable *table, uint32_t count) {
+    if (table == NULL) return;
+    uint64_t dataCapacity = (uint64_t)table->dataLength - table->count + count;
+    if (dataCapacity > table->dataCapacity && dataCapacity <= UINT32_MAX) {
+        table->dataCapacity = (uint32_t)dataCapacity;
+        table->data = (weu_hashItem*)realloc(table->data, sizeof(weu_hashItem) * table->dataCapacity);
+    }
+    uint32_t length = _weu_hashtable_capacityFor(table->engine, count);
+    if (length <= table->length) return;
+    _weu_hashtable_resize(table, length);
+    _weu_hashtable_rehashFinish(table);
+}
+void weu_hashtable_shrinkToFit(weu_hashTable *table) {
+    if (table == NULL) return;
+    _weu_hashtable_compact(table, _weu_hashtable_capacityFor(table->engine, table->count));
+    table->dataCapacity = table->dataLength > 0 ? table->dataLength : 1;
+    table->data = (weu_hashItem*)realloc(table->data, sizeof(weu_hashItem) * table->dataCapacity);
+    if (table->keys == NULL) return;
+    table->keysCapacity = table->keysLength > 0 ? table->keysLength : 1;
+    table->keys = (char*)realloc(table->keys, table->keysCapacity);
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
 //  DATA
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void* weu_hashtable_getValue(weu_hashTable *table, weu_string *key, bool freeKeyOnDone) {
     if (table == NULL || key == NULL) return NULL;
-    unsigned int hashValue = weu_hash_strFNV(key) % table->length;
-    unsigned int position    = hashValue;
-    int containsKey = 0;
-    void *out       = NULL;
-    do
-    {
-        if (position >= table->length) position = 0;
-        if (table->data[position].inUse && weu_string_matches(table->data[position].key, key)) {
-            out = table->data[position].value;
-            containsKey = 1;
-            break;
-        }
-    } while (++position != hashValue);
-    if (!containsKey) printf("weu_hashTable does not contain key - %s\n", key->text);
+    void *out = NULL;
+    if (weu_hashtable_getText(table, key->text, key->length, &out) != WEU_HASH_OK) {
+        WEU_HASHTABLE_LOG("weu_hashTable does not contain key - %s\n", key->text);
+    }
     if (freeKeyOnDone) weu_string_free(&key);
     return out;
 }
 void* weu_hashtable_getValueByIndex(weu_hashTable *table, unsigned int index) {
-    if (index >= table->length) return NULL;
+    if (table == NULL || index >= table->dataLength || !_weu_hashtable_inUse(&table->data[index])) return NULL;
     return table->data[index].value;
 }
 
 void weu_hashtable_addItem(weu_hashTable *table, weu_string *key, void *value, bool freeKeyOnDone) {
     if (table == NULL || key == NULL) return;
-    unsigned int hashValue = weu_hash_strFNV(key) % table->length;
-    unsigned int position = hashValue;
-    do
-    {
-        if (position >= table->length) position = 0;
-        if (weu_string_matches(table->data[position].key, key)) {
-            printf("weu_hashTable already contains key - %s\n", key->text);
-            break;
-        }
-        if (!table->data[position].inUse) {
-            table->data[position].inUse = 1;
-            table->data[position].value = value;
-            weu_string_setText(table->data[position].key, key->text);
-            break;
-        }
-    } while (++position == hashValue);
+    if (weu_hashtable_addText(table, key->text, key->length, value) != WEU_HASH_OK) {
+        WEU_HASHTABLE_LOG("weu_hashTable already contains key - %s\n", key->text);
+    }
     if (freeKeyOnDone) weu_string_free(&key);
 }
 void weu_hashtable_removeItem(weu_hashTable *table, weu_string *key, bool freeKeyOnDone) {
     if (table == NULL || key == NULL) return;
-    unsigned int hashValue = weu_hash_strFNV(key) % table->length;
-    unsigned int position    = hashValue;
-    int containsKey = 0;
-    do
-    {
-        if (position >= table->length) position = 0;
-        if (table->data[position].inUse && weu_string_matches(table->data[position].key, key)) {
-            table->data[position].inUse = 0;
-            weu_string_setText(table->data[position].key, "");
-            if (table->d != NULL) table->d(&table->data[position].value);
-            table->data[position].value = NULL;
-            containsKey = 1;
-            break;
-        }
-    } while (++position != hashValue);
-    if (!containsKey) printf("weu_hashTable does not conatin key - %s\n", key->text);
+    if (weu_hashtable_removeText(table, key->text, key->length) != WEU_HASH_OK) {
+        WEU_HASHTABLE_LOG("weu_hashTable does not contain key - %s\n", key->text);
+    }
     if (freeKeyOnDone) weu_string_free(&key);
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TEXT AND SLICE KEYS
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+weu_hashStatus weu_hashtable_getText(weu_hashTable *table, const char *key, uint32_t keyLen, void **valueOut) {
+    if (table == NULL || (key == NULL && keyLen > 0) || !_weu_hashtable_acceptsBytes(table, keyLen)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    uint32_t entry = _weu_hashtable_locate(table, key, keyLen, _weu_hashtable_hash(table, key, keyLen), NULL, NULL);
+    if (entry == WEU_INDEX_INVALID) {
+        if (valueOut != NULL) *valueOut = NULL;
+        return WEU_HASH_NOT_FOUND;
+    }
+    if (valueOut != NULL) *valueOut = table->data[entry].value;
+    return WEU_HASH_OK;
+}
+weu_hashStatus weu_hashtable_addText(weu_hashTable *table, const char *key, uint32_t keyLen, void *value) {
+    if (table == NULL || (key == NULL && keyLen > 0) || !_weu_hashtable_acceptsBytes(table, keyLen)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    return _weu_hashtable_insert(table, key, keyLen, _weu_hashtable_hash(table, key, keyLen), value);
+}
+weu_hashStatus weu_hashtable_removeText(weu_hashTable *table, const char *key, uint32_t keyLen) {
+    if (table == NULL || (key == NULL && keyLen > 0) || !_weu_hashtable_acceptsBytes(table, keyLen)) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    uint32_t position;
+    bool inOld;
+    if (_weu_hashtable_locate(table, key, keyLen, _weu_hashtable_hash(table, key, keyLen), &position, &inOld) == WEU_INDEX_INVALID) return WEU_HASH_NOT_FOUND;
+    _weu_hashtable_removeAt(table, inOld, position);
+    return WEU_HASH_OK;
+}
+
+weu_hashStatus weu_hashtable_getSlice(weu_hashTable *table, weu_string key, void **valueOut) {
+    return weu_hashtable_getText(table, key.text, key.length, valueOut);
+}
+weu_hashStatus weu_hashtable_addSlice(weu_hashTable *table, weu_string key, void *value) {
+    return weu_hashtable_addText(table, key.text, key.length, value);
+}
+weu_hashStatus weu_hashtable_removeSlice(weu_hashTable *table, weu_string key) {
+    return weu_hashtable_removeText(table, key.text, key.length);
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTEGER AND FIXED SIZE KEYS
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline bool _weu_hashtable_acceptsInt(const weu_hashTable *table, uint64_t key) {
+    if (table->keyMode == WEU_HASHKEY_INT32) return key <= UINT32_MAX;
+    return table->keyMode == WEU_HASHKEY_INT64;
+}
+
+weu_hashStatus weu_hashtable_getInt(weu_hashTable *table, uint64_t key, void **valueOut) {
+    if (valueOut != NULL) *valueOut = NULL;
+    if (table == NULL || !_weu_hashtable_acceptsInt(table, key)) return WEU_HASH_INVALID;
+    uint32_t entry = _weu_hashtable_locate(table, NULL, sizeof(uint64_t), weu_hash_int(key, table->seed), NULL, NULL);
+    if (entry == WEU_INDEX_INVALID) return WEU_HASH_NOT_FOUND;
+    if (valueOut != NULL) *valueOut = table->data[entry].value;
+    return WEU_HASH_OK;
+}
+weu_hashStatus weu_hashtable_addInt(weu_hashTable *table, uint64_t key, void *value) {
+    if (table == NULL || !_weu_hashtable_acceptsInt(table, key)) return WEU_HASH_INVALID;
+    return _weu_hashtable_insert(table, NULL, sizeof(uint64_t), weu_hash_int(key, table->seed), value);
+}
+weu_hashStatus weu_hashtable_removeInt(weu_hashTable *table, uint64_t key) {
+    if (table == NULL || !_weu_hashtable_acceptsInt(table, key)) return WEU_HASH_INVALID;
+    uint32_t position;
+    bool inOld;
+    if (_weu_hashtable_locate(table, NULL, sizeof(uint64_t), weu_hash_int(key, table->seed), &position, &inOld) == WEU_INDEX_INVALID) return WEU_HASH_NOT_FOUND;
+    _weu_hashtable_removeAt(table, inOld, position);
+    return WEU_HASH_OK;
+}
+bool weu_hashtable_getIntByIndex(weu_hashTable *table, unsigned int index, uint64_t *keyOut) {
+    if (table == NULL || index >= table->dataLength || !_weu_hashtable_intKeyed(table)) return false;
+    const weu_hashItem *item = &table->data[index];
+    if (!_weu_hashtable_inUse(item)) return false;
+    if (keyOut != NULL) *keyOut = _weu_hash_intInverse(item->hash, table->seed);
+    return true;
+}
+
+weu_hashStatus weu_hashtable_getKey(weu_hashTable *table, const void *key, void **valueOut) {
+    if (table == NULL) return WEU_HASH_INVALID;
+    return weu_hashtable_getText(table, (const char*)key, table->keySize, valueOut);
+}
+weu_hashStatus weu_hashtable_addKey(weu_hashTable *table, const void *key, void *value) {
+    if (table == NULL) return WEU_HASH_INVALID;
+    return weu_hashtable_addText(table, (const char*)key, table->keySize, value);
+}
+weu_hashStatus weu_hashtable_removeKey(weu_hashTable *table, const void *key) {
+    if (table == NULL) return WEU_HASH_INVALID;
+    return weu_hashtable_removeText(table, (const char*)key, table->keySize);
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  BATCH
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//  First memory probe of hash touches, control group for GROUP engine, home slot otherwise.
+static inline void _weu_hashtable_prefetchSlot(const weu_hashTable *table, uint64_t hash) {
+    if (table->ctrl != NULL)    _WEU_PREFETCH(table->ctrl + ((_weu_hashtable_h1(hash) & ((table->length - 1) >> 4)) << 4));
+    else                        _WEU_PREFETCH(&table->slots[hash & (table->length - 1)]);
+}
+//  Second memory probe touches once slot is cached, slot of first fragment match or entry of home slot.
+static inline void _weu_hashtable_prefetchKey(const weu_hashTable *table, uint64_t hash) {
+    if (table->ctrl != NULL) {
+        uint32_t group = (_weu_hashtable_h1(hash) & ((table->length - 1) >> 4)) << 4;
+        uint32_t m = _weu_hashgroup_match(table->ctrl + group, _weu_hashtable_h2(hash));
+        if (m) _WEU_PREFETCH(&table->slots[group + _weu_hashtable_ctz(m)]);
+        return;
+    }
+    const weu_hashSlot *slot = &table->slots[hash & (table->length - 1)];
+    if (_weu_hashtable_slotInUse(slot) && slot->hash == (uint32_t)hash) _WEU_PREFETCH(&table->data[slot->entry]);
+}
+static inline bool _weu_hashtable_batchHash(const weu_hashTable *table, const weu_string *keys, const uint64_t *intKeys, uint32_t i, uint64_t *hashOut) {
+    if (intKeys != NULL) {
+        if (!_weu_hashtable_acceptsInt(table, intKeys[i])) return false;
+        *hashOut = weu_hash_int(intKeys[i], table->seed);
+        return true;
+    }
+    if ((keys[i].text == NULL && keys[i].length > 0) || !_weu_hashtable_acceptsBytes(table, keys[i].length)) return false;
+    *hashOut = _weu_hashtable_hash(table, keys[i].text != NULL ? keys[i].text : "", keys[i].length);
+    return true;
+}
+//  Hashes chunk of keys and prefetches their slots, then prefetches second probe of each key,
+//  so misses of whole chunk overlap before first probe is resolved.
+static void _weu_hashtable_prepareBatch(const weu_hashTable *table, const weu_string *keys, const uint64_t *intKeys, uint32_t start, uint32_t count, uint64_t *hashes, bool *valid) {
+    for (uint32_t i = 0; i < count; i++) {
+        valid[i] = _weu_hashtable_batchHash(table, keys, intKeys, start + i, &hashes[i]);
+        if (valid[i]) _weu_hashtable_prefetchSlot(table, hashes[i]);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (valid[i]) _weu_hashtable_prefetchKey(table, hashes[i]);
+    }
+}
+//  insert - adds values, otherwise out receives found values. Returns count of found or added keys.
+static uint32_t _weu_hashtable_batch(weu_hashTable *table, const weu_string *keys, const uint64_t *intKeys, uint32_t n, bool insert, void *const *values, void **out) {
+    uint64_t hashes[WEU_HASHTABLE_BATCH];
+    bool valid[WEU_HASHTABLE_BATCH];
+    uint32_t done = 0;
+    //  Grow once up front so prefetched slot arrays stay in place
+    if (insert && (uint64_t)table->count + n <= UINT32_MAX) weu_hashtable_reserve(table, table->count + n);
+    for (uint32_t start = 0; start < n; start += WEU_HASHTABLE_BATCH) {
+        uint32_t count = n - start < WEU_HASHTABLE_BATCH ? n - start : WEU_HASHTABLE_BATCH;
+        _weu_hashtable_prepareBatch(table, keys, intKeys, start, count, hashes, valid);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t k = start + i;
+            if (!insert) out[k] = NULL;
+            if (!valid[i]) continue;
+            const char *key = intKeys != NULL ? NULL : keys[k].text != NULL ? keys[k].text : "";
+            uint32_t keyLen = intKeys != NULL ? sizeof(uint64_t) : keys[k].length;
+            if (insert) {
+                if (_weu_hashtable_insert(table, key, keyLen, hashes[i], values != NULL ? values[k] : NULL) == WEU_HASH_OK) ++done;
+                continue;
+            }
+            uint32_t entry = _weu_hashtable_locate(table, key, keyLen, hashes[i], NULL, NULL);
+            if (entry == WEU_INDEX_INVALID) continue;
+            out[k] = table->data[entry].value;
+            ++done;
+        }
+    }
+    return done;
+}
+
+uint32_t weu_hashtable_getValues(weu_hashTable *table, const weu_string *keys, uint32_t n, void **out) {
+    if (table == NULL || keys == NULL || out == NULL) return 0;
+    return _weu_hashtable_batch(table, keys, NULL, n, false, NULL, out);
+}
+uint32_t weu_hashtable_addValues(weu_hashTable *table, const weu_string *keys, void *const *values, uint32_t n) {
+    if (table == NULL || keys == NULL) return 0;
+    return _weu_hashtable_batch(table, keys, NULL, n, true, values, NULL);
+}
+uint32_t weu_hashtable_getInts(weu_hashTable *table, const uint64_t *keys, uint32_t n, void **out) {
+    if (table == NULL || keys == NULL || out == NULL) return 0;
+    return _weu_hashtable_batch(table, NULL, keys, n, false, NULL, out);
+}
+uint32_t weu_hashtable_addInts(weu_hashTable *table, const uint64_t *keys, void *const *values, uint32_t n) {
+    if (table == NULL || keys == NULL) return 0;
+    return _weu_hashtable_batch(table, NULL, keys, n, true, values, NULL);
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
 //  INDEX
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
 int weu_hashtable_getUsableIndex(weu_hashTable *table, weu_string *key, bool freeKeyOnDone) {
-    if (table == NULL || key == NULL) return -1;
-    unsigned int hashValue = weu_hash_strFNV(key) % table->length;
-    unsigned int position = hashValue;
-    do
-    {
-        if (position >= table->length) position = 0;
-        if (weu_string_matches(table->data[position].key, key)) {
-            printf("weu_hashTable already contains key - %s\n", key->text);
-            position = -1;
-            break;
-        }
-        if (!table->data[position].inUse) {
-            break;
-        }
-    } while (++position == hashValue);
+    if (table == NULL || key == NULL || !_weu_hashtable_acceptsBytes(table, key->length)) return -1;
+    uint32_t position = WEU_INDEX_INVALID;
+    if (_weu_hashtable_locate(table, key->text, key->length, _weu_hashtable_hash(table, key->text, key->length), NULL, NULL) == WEU_INDEX_INVALID) {
+        _weu_hashtable_reserveEntry(table, key->length);
+        position = table->dataLength;
+    }
+    if (position == WEU_INDEX_INVALID) WEU_HASHTABLE_LOG("weu_hashTable already contains key - %s\n", key->text);
     if (freeKeyOnDone) weu_string_free(&key);
-    return position;
+    return position == WEU_INDEX_INVALID ? -1 : (int)position;
 }
-void weu_hashtable_setDataAtIndex(weu_hashTable *table, unsigned int index, weu_string *key, void *data, bool freeKeyOnDone) {
-    if (index >= table->length) return;
-    if (table->data[index].inUse) {
-        weu_hashtable_removeItemAtIndex(table, index);    
+weu_hashStatus weu_hashtable_setDataAtIndex(weu_hashTable *table, unsigned int index, weu_string *key, void *data, bool freeKeyOnDone) {
+    if (table == NULL || key == NULL || index > table->dataLength || !_weu_hashtable_acceptsBytes(table, key->length)) return WEU_HASH_INVALID;
+    uint64_t hash = _weu_hashtable_hash(table, key->text, key->length);
+    //  Looked up before index is touched, item at index must survive refused call
+    uint32_t entry = _weu_hashtable_locate(table, key->text, key->length, hash, NULL, NULL);
+    weu_hashStatus status = WEU_HASH_OK;
+    if (entry == index) {
+        weu_hashItem *item = &table->data[index];
+        if (table->d != NULL && item->value != data) table->d(&item->value);
+        item->value = data;
+    } else if (entry != WEU_INDEX_INVALID) {
+        WEU_HASHTABLE_LOG("weu_hashTable already contains key - %s\n", key->text);
+        status = WEU_HASH_EXISTS;
+    } else if (index == table->dataLength) {
+        status = _weu_hashtable_insert(table, key->text, key->length, hash, data);
+    } else if (!_weu_hashtable_keyFits(table, key->length)) {
+        status = WEU_HASH_INVALID;
+    } else {
+        weu_hashtable_removeItemAtIndex(table, index);
+        status = _weu_hashtable_insertAt(table, index, key->text, key->length, hash, data);
     }
-    table->data[index].inUse = 1;
-    table->data[index].key = weu_string_copy(key);
-    table->data[index].value = data;
     if (freeKeyOnDone) weu_string_free(&key);
+    return status;
 }
 void weu_hashtable_removeItemAtIndex(weu_hashTable *table, unsigned int index) {
-    if (table == NULL || index >= table->length) return;
-    table->data[index].inUse = false;
-    if (table->d != NULL) table->d(&table->data[index].value);
-    table->data[index].value = NULL;
+    if (table == NULL || index >= table->dataLength) return;
+    const weu_hashItem *item = &table->data[index];
+    if (!_weu_hashtable_inUse(item)) return;
+    bool inOld = false;
+    uint32_t position = _weu_hashtable_findEntry(table->slots, table->ctrl, table->length, index, item->hash);
+    if (position == WEU_INDEX_INVALID && table->oldSlots != NULL) {
+        position = _weu_hashtable_findEntry(table->oldSlots, table->oldCtrl, table->oldLength, index, item->hash);
+        inOld = true;
+    }
+    if (position != WEU_INDEX_INVALID) _weu_hashtable_removeAt(table, inOld, position);
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  GET KEY
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
-weu_string* weu_hashtable_getKeyByIndex(weu_hashTable *table, unsigned int index) {
-    if (index >= table->length) return NULL;
-    return table->data[index].key;
+weu_string weu_hashtable_getKeyByIndex(weu_hashTable *table, unsigned int index) {
+    if (table == NULL || index >= table->dataLength || _weu_hashtable_intKeyed(table)) return (weu_string){0};
+    const weu_hashItem *item = &table->data[index];
+    if (!_weu_hashtable_inUse(item)) return (weu_string){0};
+    return (weu_string){.allocLength = 0, .charPtrPos = 0, .length = item->keyLength, .text = table->keys + item->keyOffset};
 }
 int weu_hashtable_getKeyIndex(weu_hashTable *table, weu_string *key, bool freeKeyOnDone) {
-    if (table == NULL || key == NULL) return -1;
-    unsigned int hashValue = weu_hash_strFNV(key) % table->length;
-    unsigned int position    = hashValue;
-    int out         = -1;
-    do
-    {
-        if (position >= table->length) position = 0;
-        if (table->data[position].inUse && weu_string_matches(table->data[position].key, key)) {
-            out = position; break; 
-        }
-    } while (++position != hashValue);
-    if (out == -1) printf("weu_hashTable does not contain key - %s\n", key->text);
+    if (table == NULL || key == NULL || !_weu_hashtable_acceptsBytes(table, key->length)) return -1;
+    uint32_t entry = _weu_hashtable_locate(table, key->text, key->length, _weu_hashtable_hash(table, key->text, key->length), NULL, NULL);
+    if (entry == WEU_INDEX_INVALID) WEU_HASHTABLE_LOG("weu_hashTable does not contain key - %s\n", key->text);
     if (freeKeyOnDone) weu_string_free(&key);
+    return entry == WEU_INDEX_INVALID ? -1 : (int)entry;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ITERATION
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//  Advances iterator past removed entries, returns entry index or WEU_INDEX_INVALID at end.
+static inline uint32_t _weu_hashtable_nextEntry(const weu_hashTable *table, uint32_t *iterator) {
+    while (*iterator < table->dataLength) {
+        uint32_t entry = (*iterator)++;
+        if (_weu_hashtable_inUse(&table->data[entry])) return entry;
+    }
+    return WEU_INDEX_INVALID;
+}
+bool weu_hashtable_next(weu_hashTable *table, uint32_t *iterator, weu_string *keyOut, void **valueOut) {
+    if (table == NULL || iterator == NULL) return false;
+    uint32_t entry = _weu_hashtable_nextEntry(table, iterator);
+    if (entry == WEU_INDEX_INVALID) return false;
+    if (keyOut != NULL) *keyOut = weu_hashtable_getKeyByIndex(table, entry);
+    if (valueOut != NULL) *valueOut = table->data[entry].value;
+    return true;
+}
+bool weu_hashtable_nextInt(weu_hashTable *table, uint32_t *iterator, uint64_t *keyOut, void **valueOut) {
+    if (table == NULL || iterator == NULL || !_weu_hashtable_intKeyed(table)) return false;
+    uint32_t entry = _weu_hashtable_nextEntry(table, iterator);
+    if (entry == WEU_INDEX_INVALID) return false;
+    if (keyOut != NULL) *keyOut = _weu_hash_intInverse(table->data[entry].hash, table->seed);
+    if (valueOut != NULL) *valueOut = table->data[entry].value;
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  STATS
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef WEU_HASHTABLE_STATS
+//  Probes from home slot or group of hash until position is reached, counting probed slots or groups.
+static uint32_t _weu_hashtable_probeLength(const uint8_t *ctrl, uint32_t length, uint32_t position, uint64_t hash) {
+    uint32_t mask = length - 1;
+    if (ctrl == NULL) return ((position - (uint32_t)hash) & mask) + 1;
+    uint32_t groupMask = mask >> 4;
+    uint32_t group = _weu_hashtable_h1(hash) & groupMask;
+    uint32_t probe = 1;
+    while (group != position >> 4 && probe <= groupMask) {
+        group = (group + probe) & groupMask;
+        ++probe;
+    }
+    return probe;
+}
+static void _weu_hashtable_statsSlots(const weu_hashSlot *slots, const uint8_t *ctrl, uint32_t length, uint32_t from, weu_hashTableStats *out, uint64_t *probeSum) {
+    for (uint32_t i = from; i < length; i++) {
+        if (slots[i].entry == WEU_HASHITEM_DELETED) ++out->tombstones;
+        if (!_weu_hashtable_slotInUse(&slots[i])) continue;
+        uint32_t probe = _weu_hashtable_probeLength(ctrl, length, i, slots[i].hash);
+        *probeSum += probe;
+        if (probe > out->maxProbe) out->maxProbe = probe;
+        ++out->probeHistogram[probe < WEU_HASHTABLE_STATS_HISTOGRAM ? probe - 1 : WEU_HASHTABLE_STATS_HISTOGRAM - 1];
+    }
+}
+void weu_hashtable_stats(const weu_hashTable *table, weu_hashTableStats *out) {
+    if (out == NULL) return;
+    *out = (weu_hashTableStats){0};
+    if (table == NULL) return;
+    uint64_t probeSum = 0;
+    _weu_hashtable_statsSlots(table->slots, table->ctrl, table->length, 0, out, &probeSum);
+    if (table->oldSlots != NULL) _weu_hashtable_statsSlots(table->oldSlots, table->oldCtrl, table->oldLength, table->rehashPos, out, &probeSum);
+    out->count          = table->count;
+    out->length         = table->length;
+    out->removedEntries = table->dataLength - table->count;
+    out->loadFactor     = (float)(table->count + table->deleted) / (float)table->length;
+    out->meanProbe      = table->count > 0 ? (float)((double)probeSum / table->count) : 0.0f;
+    out->counters       = table->counters;
+}
+void weu_hashtable_resetStats(weu_hashTable *table) {
+    if (table != NULL) table->counters = (weu_hashCounters){0};
+}
+#endif
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FREEZE
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//  Bucket and position are taken from hash remixed with salt, so 32 bit hashes of FNV
+//  and custom hashers spread over all buckets like 64 bit ones.
+static inline uint64_t _weu_frozen_mix(uint64_t hash, uint64_t salt) {
+    return _weu_hash_fmix64(hash ^ salt);
+}
+//  60% of keys share first 30% of buckets, large buckets are placed while most entries are free
+//  and buckets left for end are small enough to fit remaining gaps.
+static inline uint32_t _weu_frozen_bucket(uint64_t hash, uint32_t bucketCount) {
+    uint32_t dense = bucketCount * 3 / 10;
+    if ((uint32_t)(hash >> 32) < 0x9999999aU) return (uint32_t)(((hash & 0xffffffff) * dense) >> 32);
+    return dense + (uint32_t)(((hash & 0xffffffff) * (bucketCount - dense)) >> 32);
+}
+//  Whole hash is remixed with pilot, keys of same bucket move independently of each other.
+static inline uint32_t _weu_frozen_position(uint64_t hash, uint32_t pilot, uint64_t salt, uint32_t slotCount) {
+    uint64_t x = _weu_hash_fmix64(hash ^ ((salt + pilot) * 0x9e3779b97f4a7c15ULL));
+    return (uint32_t)(((x >> 32) * slotCount) >> 32);
+}
+//  Finds pilot for every bucket, largest buckets first while most positions are free.
+//  taken receives bitmap of positions in use, positions receives position of every hash.
+static bool _weu_frozen_build(const uint64_t *hashes, uint32_t n, uint32_t slotCount, uint32_t bucketCount, uint64_t salt,
+                              uint16_t *pilots, uint64_t *taken, uint32_t *positions) {
+    uint32_t *start     = (uint32_t*)calloc((size_t)bucketCount + 1, sizeof(uint32_t));
+    uint32_t *members   = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t *order     = (uint32_t*)malloc(sizeof(uint32_t) * bucketCount);
+    uint64_t *mixed     = (uint64_t*)malloc(sizeof(uint64_t) * (n + 1));
+    for (uint32_t i = 0; i < n; i++) mixed[i] = _weu_frozen_mix(hashes[i], salt);
+    //  Bucket sizes summed to bucket ends, filling backwards leaves start[b] at first member of b
+    for (uint32_t i = 0; i < n; i++) start[_weu_frozen_bucket(mixed[i], bucketCount)]++;
+    uint32_t maxSize = 0;
+    for (uint32_t b = 0; b < bucketCount; b++) {
+        if (start[b] > maxSize) maxSize = start[b];
+        if (b > 0) start[b] += start[b - 1];
+    }
+    start[bucketCount] = n;
+    for (uint32_t i = 0; i < n; i++) members[--start[_weu_frozen_bucket(mixed[i], bucketCount)]] = i;
+    //  Counting sort of buckets by size, descending
+    uint32_t *sizeStart = (uint32_t*)calloc((size_t)maxSize + 2, sizeof(uint32_t));
+    for (uint32_t b = 0; b < bucketCount; b++) sizeStart[maxSize - (start[b + 1] - start[b]) + 1]++;
+    for (uint32_t i = 0; i <= maxSize; i++) sizeStart[i + 1] += sizeStart[i];
+    for (uint32_t b = 0; b < bucketCount; b++) order[sizeStart[maxSize - (start[b + 1] - start[b])]++] = b;
+    free(sizeStart);
+
+    memset(taken, 0, sizeof(uint64_t) * ((slotCount + 63) >> 6));
+    bool out = true;
+    for (uint32_t k = 0; k < bucketCount && out; k++) {
+        uint32_t b = order[k];
+        const uint32_t *bucket = members + start[b];
+        uint32_t size = start[b + 1] - start[b];
+        pilots[b] = 0;
+        if (size == 0) continue;
+        out = false;
+        for (uint32_t pilot = 0; pilot <= UINT16_MAX; pilot++) {
+            uint32_t j = 0;
+            for (; j < size; j++) {
+                uint32_t position = _weu_frozen_position(mixed[bucket[j]], pilot, salt, slotCount);
+                if (taken[position >> 6] >> (position & 63) & 1) break;
+                taken[position >> 6] |= 1ULL << (position & 63);
+                positions[bucket[j]] = position;
+            }
+            if (j == size) {
+                pilots[b] = (uint16_t)pilot;
+                out = true;
+                break;
+            }
+            while (j-- > 0) taken[positions[bucket[j]] >> 6] &= ~(1ULL << (positions[bucket[j]] & 63));
+        }
+    }
+    free(start);
+    free(members);
+    free(order);
+    free(mixed);
+    return out;
+}
+static inline uint64_t _weu_frozen_hashBytes(const weu_hashTable *table, weu_hashFunction fun, const char *key, uint32_t keyLen, uint64_t seed) {
+    if (table->keyMode == WEU_HASHKEY_CUSTOM) return table->keyHash(key, keyLen, seed);
+    return weu_hash(fun, key, keyLen, seed);
+}
+//  Minimal perfect hash over live entries of table, shared by freeze and snapshot writer.
+//  entryOf - dense entry index of k-th live entry, live - its index in table data
+typedef struct _weu_frozenIndex {
+    uint32_t count, slotCount, bucketCount;
+    uint64_t seed, salt;
+    weu_hashFunction hashFun;
+    uint16_t *pilots;
+    uint32_t *remap, *live, *entryOf;
+    uint64_t *hashes;
+} _weu_frozenIndex;
+
+static void _weu_frozen_indexFree(_weu_frozenIndex *index) {
+    free(index->pilots);
+    free(index->remap);
+    free(index->live);
+    free(index->entryOf);
+    free(index->hashes);
+    *index = (_weu_frozenIndex){0};
+}
+static bool _weu_frozen_index(const weu_hashTable *table, _weu_frozenIndex *out) {
+    bool intKeyed = _weu_hashtable_intKeyed(table);
+    uint32_t n = table->count;
+    *out = (_weu_frozenIndex){.count = n, .seed = table->seed, .hashFun = table->hashFun, .bucketCount = n / WEU_HASHTABLE_FROZEN_BUCKET + 1};
+    out->live       = (uint32_t*)malloc(sizeof(uint32_t) * (n + 1));
+    out->hashes     = (uint64_t*)malloc(sizeof(uint64_t) * (n + 1));
+    out->entryOf    = (uint32_t*)malloc(sizeof(uint32_t) * (n + 1));
+    out->pilots     = (uint16_t*)malloc(sizeof(uint16_t) * out->bucketCount);
+    for (uint32_t i = 0, k = 0; i < table->dataLength; i++) {
+        if (!_weu_hashtable_inUse(&table->data[i])) continue;
+        out->hashes[k] = table->data[i].hash;
+        out->live[k++] = i;
+    }
+    uint64_t *taken = NULL;
+    bool built = false;
+    for (uint32_t attempt = 0; attempt < WEU_HASHTABLE_FROZEN_ATTEMPTS && !built; attempt++) {
+        //  About 1% spare positions keep last buckets from searching long for free entry, doubled on retry
+        out->slotCount = n + ((n >> 7) << attempt) + WEU_HASHTABLE_FROZEN_BUCKET * 2;
+        out->salt = (uint64_t)attempt << 16;
+        taken = (uint64_t*)realloc(taken, sizeof(uint64_t) * ((out->slotCount + 63) >> 6));
+        //  Equal hashes of distinct byte keys never separate, retries rehash them with new seed. Crc
+        //  collisions of equal length keys stay under any seed, so retries switch to wyhash.
+        if (attempt > 0 && !intKeyed) {
+            out->seed = weu_hash_int(table->seed, attempt);
+            out->hashFun = WEU_HASHFUN_WY;
+            for (uint32_t k = 0; k < n; k++) {
+                const weu_hashItem *item = &table->data[out->live[k]];
+                out->hashes[k] = _weu_frozen_hashBytes(table, out->hashFun, table->keys + item->keyOffset, item->keyLength, out->seed);
+            }
+        }
+        built = _weu_frozen_build(out->hashes, n, out->slotCount, out->bucketCount, out->salt, out->pilots, taken, out->entryOf);
+    }
+    if (built) {
+        //  Positions past count are taken by as many keys as there are free entries below count
+        out->remap = (uint32_t*)malloc(sizeof(uint32_t) * (out->slotCount - n));
+        for (uint32_t position = n, spare = 0; position < out->slotCount; position++) {
+            out->remap[position - n] = 0;
+            if (!(taken[position >> 6] >> (position & 63) & 1)) continue;
+            while (taken[spare >> 6] >> (spare & 63) & 1) spare++;
+            out->remap[position - n] = spare++;
+        }
+        for (uint32_t k = 0; k < n; k++) {
+            if (out->entryOf[k] >= n) out->entryOf[k] = out->remap[out->entryOf[k] - n];
+        }
+    }
+    free(taken);
+    if (!built) _weu_frozen_indexFree(out);
+    return built;
+}
+weu_frozenHashTable *weu_hashtable_freeze(weu_hashTable **handle) {
+    if (handle == NULL || *handle == NULL) return NULL;
+    weu_hashTable *table = *handle;
+    _weu_frozenIndex index;
+    if (!_weu_frozen_index(table, &index)) return NULL;
+    weu_frozenHashTable *out = (weu_frozenHashTable*)calloc(1, sizeof(weu_frozenHashTable));
+    out->count          = index.count;
+    out->slotCount      = index.slotCount;
+    out->bucketCount    = index.bucketCount;
+    out->pilots         = index.pilots;
+    out->remap          = index.remap;
+    out->salt           = index.salt;
+    out->hashFun        = index.hashFun;
+    out->seed           = index.seed;
+    out->keyMode        = table->keyMode;
+    out->keySize        = table->keySize;
+    out->keyHash        = table->keyHash;
+    out->keyCompare     = table->keyCompare;
+    out->d              = table->d;
+    index.pilots = NULL;
+    index.remap  = NULL;
+    uint64_t keysLength = 0;
+    if (!_weu_hashtable_intKeyed(table)) {
+        for (uint32_t k = 0; k < index.count; k++) keysLength += table->data[index.live[k]].keyLength + 1;
+        out->keys = (char*)malloc(keysLength + 1);
+    }
+    out->data = (weu_hashItem*)malloc(sizeof(weu_hashItem) * (index.count + 1));
+    uint32_t keysOffset = 0;
+    for (uint32_t k = 0; k < index.count; k++) {
+        weu_hashItem item = table->data[index.live[k]];
+        item.hash = index.hashes[k];
+        if (out->keys != NULL) {
+            memcpy(out->keys + keysOffset, table->keys + item.keyOffset, item.keyLength + 1);
+            item.keyOffset = keysOffset;
+            keysOffset += item.keyLength + 1;
+        }
+        out->data[index.entryOf[k]] = item;
+    }
+    _weu_frozen_indexFree(&index);
+    //  Values belong to frozen table now
+    table->d = NULL;
+    weu_hashtable_free(handle);
     return out;
 }
+void weu_frozenHashTable_free(weu_frozenHashTable **handle) {
+    weu_frozenHashTable *table = (*handle);
+    if (table == NULL) return;
+    if (table->d != NULL) {
+        for (uint32_t i = 0; i < table->count; i++) table->d(&table->data[i].value);
+    }
+    free(table->pilots);
+    free(table->remap);
+    free(table->data);
+    free(table->keys);
+    free(table);
+    *handle = NULL;
+}
+//  Single probe, returns only entry key can be stored at or NULL.
+static inline const weu_hashItem *_weu_frozenHashTable_find(const weu_frozenHashTable *table, const char *key, uint32_t keyLen, uint64_t hash) {
+    if (table->count == 0) return NULL;
+    uint64_t mixed = _weu_frozen_mix(hash, table->salt);
+    uint32_t pilot = table->pilots[_weu_frozen_bucket(mixed, table->bucketCount)];
+    uint32_t position = _weu_frozen_position(mixed, pilot, table->salt, table->slotCount);
+    if (position >= table->count) position = table->remap[position - table->count];
+    const weu_hashItem *item = &table->data[position];
+    if (item->hash != hash || item->keyLength != keyLen) return NULL;
+    switch (table->keyMode) {
+    case WEU_HASHKEY_INT32:
+    case WEU_HASHKEY_INT64:     return item;
+    case WEU_HASHKEY_CUSTOM:    return table->keyCompare(table->keys + item->keyOffset, key, keyLen) ? item : NULL;
+    default:                    return memcmp(table->keys + item->keyOffset, key, keyLen) == 0 ? item : NULL;
+    }
+}
+static inline weu_hashStatus _weu_frozenHashTable_result(const weu_hashItem *item, void **valueOut) {
+    if (valueOut != NULL) *valueOut = item != NULL ? item->value : NULL;
+    return item != NULL ? WEU_HASH_OK : WEU_HASH_NOT_FOUND;
+}
+weu_hashStatus weu_frozenHashTable_getText(const weu_frozenHashTable *table, const char *key, uint32_t keyLen, void **valueOut) {
+    if (valueOut != NULL) *valueOut = NULL;
+    if (table == NULL || (key == NULL && keyLen > 0)) return WEU_HASH_INVALID;
+    if (table->keyMode == WEU_HASHKEY_INT32 || table->keyMode == WEU_HASHKEY_INT64) return WEU_HASH_INVALID;
+    if (table->keyMode == WEU_HASHKEY_POD && keyLen != table->keySize) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    uint64_t hash = table->keyMode == WEU_HASHKEY_CUSTOM ? table->keyHash(key, keyLen, table->seed) : weu_hash(table->hashFun, key, keyLen, table->seed);
+    return _weu_frozenHashTable_result(_weu_frozenHashTable_find(table, key, keyLen, hash), valueOut);
+}
+weu_hashStatus weu_frozenHashTable_getSlice(const weu_frozenHashTable *table, weu_string key, void **valueOut) {
+    return weu_frozenHashTable_getText(table, key.text, key.length, valueOut);
+}
+weu_hashStatus weu_frozenHashTable_getInt(const weu_frozenHashTable *table, uint64_t key, void **valueOut) {
+    if (valueOut != NULL) *valueOut = NULL;
+    if (table == NULL) return WEU_HASH_INVALID;
+    if (table->keyMode != WEU_HASHKEY_INT64 && (table->keyMode != WEU_HASHKEY_INT32 || key > UINT32_MAX)) return WEU_HASH_INVALID;
+    return _weu_frozenHashTable_result(_weu_frozenHashTable_find(table, NULL, sizeof(uint64_t), weu_hash_int(key, table->seed)), valueOut);
+}
+weu_hashStatus weu_frozenHashTable_getKey(const weu_frozenHashTable *table, const void *key, void **valueOut) {
+    if (table == NULL) return WEU_HASH_INVALID;
+    return weu_frozenHashTable_getText(table, (const char*)key, table->keySize, valueOut);
+}
 
 #endif
 #endif
\ No newline at end of file
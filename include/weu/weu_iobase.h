@@ -20,9 +20,15 @@
 
 #include "weu_datatypes.h"
 #include "weu_string.h"
+#include "weu_hashtable.h"
+#include "weu_stringbuilder.h"
 
 #include <stdio.h>
 
+#define WEU_HASHSNAPSHOT_MAGIC      "WEUHASH"
+//  Version 2 takes bucket and position from hash remixed with salt and hashes FNV keys with 64 bit FNV-1a.
+#define WEU_HASHSNAPSHOT_VERSION    2
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  READ
 
@@ -33,6 +39,29 @@ WEUDEF weu_string *weu_io_loadText(const char *filePath);
 
 WEUDEF void weu_io_writeFile(const char *filePath, const char *text);
 WEUDEF void weu_io_appendFile(const char *filePath, const char *text);
+//  Writes chunks of builder one after another, text is never joined in memory.
+//  Returns false on io error.
+WEUDEF bool weu_io_writeStringBuilder(const char *filePath, const weu_stringBuilder *b);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  HASHTABLE SNAPSHOT
+//  Versioned binary image of weu_hashTable - header, minimal perfect hash index, entries, key bytes
+//  and value bytes. Keys and values are referenced by offsets, mapped file is queried in place with
+//  no fixup and processes mapping same file share its page cache.
+
+//  valueSize returns byte count copied from each value pointer, NULL stores value pointer itself
+//  as 64 bit integer. Writes to temporary file renamed over filePath, so readers mapping old file
+//  keep valid view. Returns false for CUSTOM key tables, on io error or when index cannot be
+//  built, which happens under same conditions as weu_hashtable_freeze returning NULL.
+WEUDEF bool weu_io_writeHashtable(const char *filePath, const weu_hashTable *table, valuesizefun valueSize);
+//  Maps file read only, returns NULL if file is missing or is not valid snapshot of this version.
+WEUDEF weu_hashSnapshot *weu_io_mapHashtable(const char *filePath);
+WEUDEF void weu_io_unmapHashtable(weu_hashSnapshot **handle);
+
+//  valueOut points into mapped file and valueLengthOut receives its byte count,
+//  snapshots with inline values return stored value as pointer and length 0. Both can be NULL.
+WEUDEF weu_hashStatus weu_hashSnapshot_getText(const weu_hashSnapshot *snapshot, const char *key, uint32_t keyLen, const void **valueOut, uint32_t *valueLengthOut);
+WEUDEF weu_hashStatus weu_hashSnapshot_getSlice(const weu_hashSnapshot *snapshot, weu_string key, const void **valueOut, uint32_t *valueLengthOut);
+WEUDEF weu_hashStatus weu_hashSnapshot_getInt(const weu_hashSnapshot *snapshot, uint64_t key, const void **valueOut, uint32_t *valueLengthOut);
 
 #ifdef WEU_IMPLEMENTATION
 
@@ -73,6 +102,241 @@ void weu_io_appendFile(const char *filePath, const char *text) {
     fprintf(file, text);
     fclose(file);
 }
+bool weu_io_writeStringBuilder(const char *filePath, const weu_stringBuilder *b) {
+    if (b == NULL) return false;
+    FILE *file = fopen(filePath, "wb");
+    if (file == NULL) return false;
+    bool out = true;
+    for (uint32_t i = 0; i < b->chunkCount && out; i++) {
+        uint32_t length = i + 1 < b->chunkCount ? b->chunkSize : b->used;
+        out = fwrite(b->chunks[i], 1, length, file) == length;
+    }
+    return fclose(file) == 0 && out;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  HASHTABLE SNAPSHOT
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define _WEU_SNAPSHOT_BYTE_ORDER 0x01020304
+
+static inline uint64_t _weu_io_align8(uint64_t offset) {
+    return (offset + 7) & ~(uint64_t)7;
+}
+static bool _weu_io_writePadded(FILE *file, const void *data, uint64_t length, uint64_t *offset) {
+    static const uint8_t zero[8] = {0};
+    if (length > 0 && fwrite(data, 1, length, file) != length) return false;
+    *offset += length;
+    uint64_t padding = _weu_io_align8(*offset) - *offset;
+    *offset += padding;
+    return padding == 0 || fwrite(zero, 1, padding, file) == padding;
+}
+bool weu_io_writeHashtable(const char *filePath, const weu_hashTable *table, valuesizefun valueSize) {
+    if (filePath == NULL || table == NULL || table->keyMode == WEU_HASHKEY_CUSTOM) return false;
+    _weu_frozenIndex index;
+    if (!_weu_frozen_index(table, &index)) return false;
+    bool intKeyed = _weu_hashtable_intKeyed(table);
+    uint32_t n = index.count;
+    weu_hashSnapshotEntry *entries = (weu_hashSnapshotEntry*)calloc((size_t)n + 1, sizeof(weu_hashSnapshotEntry));
+    uint64_t keysLength = 0, valuesLength = 0;
+    for (uint32_t k = 0; k < n; k++) {
+        const weu_hashItem *item = &table->data[index.live[k]];
+        weu_hashSnapshotEntry *entry = &entries[index.entryOf[k]];
+        entry->hash         = index.hashes[k];
+        entry->keyLength    = item->keyLength;
+        if (!intKeyed) {
+            entry->keyOffset = (uint32_t)keysLength;
+            keysLength += item->keyLength + 1;
+        }
+        if (valueSize == NULL) {
+            entry->value = (uint64_t)(uintptr_t)item->value;
+        } else {
+            entry->valueLength  = item->value != NULL ? valueSize(item->value) : 0;
+            entry->value        = valuesLength;
+            valuesLength        = _weu_io_align8(valuesLength + entry->valueLength);
+        }
+    }
+    weu_hashSnapshotHeader header = {
+        .magic = WEU_HASHSNAPSHOT_MAGIC, .version = WEU_HASHSNAPSHOT_VERSION, .byteOrder = _WEU_SNAPSHOT_BYTE_ORDER,
+        .headerSize = sizeof(weu_hashSnapshotHeader), .entrySize = sizeof(weu_hashSnapshotEntry),
+        .count = n, .slotCount = index.slotCount, .bucketCount = index.bucketCount,
+        .keyMode = table->keyMode, .keySize = table->keySize, .hashFun = index.hashFun, .inlineValues = valueSize == NULL,
+        .seed = index.seed, .salt = index.salt, .keysLength = keysLength, .valuesLength = valuesLength
+    };
+    header.pilotsOffset     = _weu_io_align8(sizeof(weu_hashSnapshotHeader));
+    header.remapOffset      = _weu_io_align8(header.pilotsOffset + sizeof(uint16_t) * index.bucketCount);
+    header.entriesOffset    = _weu_io_align8(header.remapOffset + sizeof(uint32_t) * (index.slotCount - n));
+    header.keysOffset       = _weu_io_align8(header.entriesOffset + sizeof(weu_hashSnapshotEntry) * n);
+    header.valuesOffset     = _weu_io_align8(header.keysOffset + keysLength);
+    header.fileSize         = header.valuesOffset + valuesLength;
+
+    //  Renaming finished file over old one never truncates pages other processes have mapped
+    weu_string *tempPath = weu_string_new(filePath);
+    weu_string_concateText(tempPath, 1, ".tmp");
+    FILE *file = fopen(tempPath->text, "wb");
+    bool out = file != NULL;
+    uint64_t offset = 0;
+    out = out && _weu_io_writePadded(file, &header, sizeof(header), &offset);
+    out = out && _weu_io_writePadded(file, index.pilots, sizeof(uint16_t) * index.bucketCount, &offset);
+    out = out && _weu_io_writePadded(file, index.remap, sizeof(uint32_t) * (index.slotCount - n), &offset);
+    out = out && _weu_io_writePadded(file, entries, sizeof(weu_hashSnapshotEntry) * n, &offset);
+    for (uint32_t k = 0; k < n && out && !intKeyed; k++) {
+        const weu_hashItem *item = &table->data[index.live[k]];
+        out = fwrite(table->keys + item->keyOffset, 1, item->keyLength + 1, file) == item->keyLength + 1;
+        offset += item->keyLength + 1;
+    }
+    out = out && _weu_io_writePadded(file, NULL, 0, &offset);
+    for (uint32_t k = 0; k < n && out && valueSize != NULL; k++) {
+        const weu_hashSnapshotEntry *entry = &entries[index.entryOf[k]];
+        out = _weu_io_writePadded(file, table->data[index.live[k]].value, entry->valueLength, &offset);
+    }
+    if (file != NULL && fclose(file) != 0) out = false;
+    out = out && offset == header.fileSize && rename(tempPath->text, filePath) == 0;
+    if (!out) remove(tempPath->text);
+    weu_string_free(&tempPath);
+    free(entries);
+    _weu_frozen_indexFree(&index);
+    return out;
+}
+//  Checks every section lies inside file, lookups only bound check offsets read from entries.
+static bool _weu_io_snapshotValid(const uint8_t *base, uint64_t size) {
+    if (size < sizeof(weu_hashSnapshotHeader)) return false;
+    const weu_hashSnapshotHeader *header = (const weu_hashSnapshotHeader*)base;
+    if (memcmp(header->magic, WEU_HASHSNAPSHOT_MAGIC, sizeof(WEU_HASHSNAPSHOT_MAGIC)) != 0) return false;
+    if (header->version != WEU_HASHSNAPSHOT_VERSION || header->byteOrder != _WEU_SNAPSHOT_BYTE_ORDER) return false;
+    if (header->headerSize != sizeof(weu_hashSnapshotHeader) || header->entrySize != sizeof(weu_hashSnapshotEntry)) return false;
+    if (header->fileSize != size || header->bucketCount == 0 || header->slotCount < header->count) return false;
+    if (header->keyMode > WEU_HASHKEY_POD || header->hashFun > WEU_HASHFUN_FNV) return false;
+    uint64_t sections[5][2] = {
+        {header->pilotsOffset,  sizeof(uint16_t) * (uint64_t)header->bucketCount},
+        {header->remapOffset,   sizeof(uint32_t) * (uint64_t)(header->slotCount - header->count)},
+        {header->entriesOffset, sizeof(weu_hashSnapshotEntry) * (uint64_t)header->count},
+        {header->keysOffset,    header->keysLength},
+        {header->valuesOffset,  header->valuesLength},
+    };
+    for (uint32_t i = 0; i < 5; i++) {
+        if (sections[i][0] & 7 || sections[i][0] > size || sections[i][1] > size - sections[i][0]) return false;
+    }
+    return true;
+}
+weu_hashSnapshot *weu_io_mapHashtable(const char *filePath) {
+    if (filePath == NULL) return NULL;
+    const uint8_t *base = NULL;
+    uint64_t size = 0;
+    bool mapped = false;
+#ifndef _WIN32
+    int fd = open(filePath, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        size = (uint64_t)info.st_size;
+        void *view = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (view != MAP_FAILED) {
+            base = (const uint8_t*)view;
+            mapped = true;
+        }
+    }
+    close(fd);
+#else
+    //  No mmap, file is read to memory once and still queried without deserializing
+    FILE *file = fopen(filePath, "rb");
+    if (file == NULL) return NULL;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    rewind(file);
+    if (length > 0) {
+        uint8_t *buffer = (uint8_t*)malloc((size_t)length);
+        if (fread(buffer, 1, (size_t)length, file) == (size_t)length) {
+            base = buffer;
+            size = (uint64_t)length;
+        } else {
+            free(buffer);
+        }
+    }
+    fclose(file);
+#endif
+    if (base == NULL) return NULL;
+    weu_hashSnapshot *out = (weu_hashSnapshot*)malloc(sizeof(weu_hashSnapshot));
+    *out = (weu_hashSnapshot){.base = base, .size = size, .mapped = mapped};
+    if (!_weu_io_snapshotValid(base, size)) {
+        weu_io_unmapHashtable(&out);
+        return NULL;
+    }
+    out->header     = (const weu_hashSnapshotHeader*)base;
+    out->pilots     = (const uint16_t*)(base + out->header->pilotsOffset);
+    out->remap      = (const uint32_t*)(base + out->header->remapOffset);
+    out->entries    = (const weu_hashSnapshotEntry*)(base + out->header->entriesOffset);
+    out->keys       = (const char*)(base + out->header->keysOffset);
+    out->values     = base + out->header->valuesOffset;
+    return out;
+}
+void weu_io_unmapHashtable(weu_hashSnapshot **handle) {
+    weu_hashSnapshot *snapshot = (*handle);
+    if (snapshot == NULL) return;
+#ifndef _WIN32
+    if (snapshot->mapped) munmap((void*)snapshot->base, snapshot->size);
+    else free((void*)snapshot->base);
+#else
+    free((void*)snapshot->base);
+#endif
+    free(snapshot);
+    *handle = NULL;
+}
+//  Same single probe as weu_frozenHashTable, every offset read from file is bound checked.
+static weu_hashStatus _weu_hashSnapshot_find(const weu_hashSnapshot *snapshot, const char *key, uint32_t keyLen, uint64_t hash,
+                                             const void **valueOut, uint32_t *valueLengthOut) {
+    const weu_hashSnapshotHeader *header = snapshot->header;
+    if (header->count == 0) return WEU_HASH_NOT_FOUND;
+    uint64_t mixed = _weu_frozen_mix(hash, header->salt);
+    uint32_t pilot = snapshot->pilots[_weu_frozen_bucket(mixed, header->bucketCount)];
+    uint32_t position = _weu_frozen_position(mixed, pilot, header->salt, header->slotCount);
+    if (position >= header->count) position = snapshot->remap[position - header->count];
+    if (position >= header->count) return WEU_HASH_NOT_FOUND;
+    const weu_hashSnapshotEntry *entry = &snapshot->entries[position];
+    if (entry->hash != hash || entry->keyLength != keyLen) return WEU_HASH_NOT_FOUND;
+    if (key != NULL) {
+        if ((uint64_t)entry->keyOffset + keyLen > header->keysLength) return WEU_HASH_INVALID;
+        if (memcmp(snapshot->keys + entry->keyOffset, key, keyLen) != 0) return WEU_HASH_NOT_FOUND;
+    }
+    if (header->inlineValues) {
+        if (valueOut != NULL) *valueOut = (const void*)(uintptr_t)entry->value;
+        return WEU_HASH_OK;
+    }
+    if (entry->value > header->valuesLength || entry->valueLength > header->valuesLength - entry->value) return WEU_HASH_INVALID;
+    if (valueOut != NULL) *valueOut = snapshot->values + entry->value;
+    if (valueLengthOut != NULL) *valueLengthOut = entry->valueLength;
+    return WEU_HASH_OK;
+}
+weu_hashStatus weu_hashSnapshot_getText(const weu_hashSnapshot *snapshot, const char *key, uint32_t keyLen, const void **valueOut, uint32_t *valueLengthOut) {
+    if (valueOut != NULL) *valueOut = NULL;
+    if (valueLengthOut != NULL) *valueLengthOut = 0;
+    if (snapshot == NULL || (key == NULL && keyLen > 0)) return WEU_HASH_INVALID;
+    const weu_hashSnapshotHeader *header = snapshot->header;
+    if (header->keyMode == WEU_HASHKEY_INT32 || header->keyMode == WEU_HASHKEY_INT64) return WEU_HASH_INVALID;
+    if (header->keyMode == WEU_HASHKEY_POD && keyLen != header->keySize) return WEU_HASH_INVALID;
+    if (key == NULL) key = "";
+    uint64_t hash = weu_hash((weu_hashFunction)header->hashFun, key, keyLen, header->seed);
+    return _weu_hashSnapshot_find(snapshot, key, keyLen, hash, valueOut, valueLengthOut);
+}
+weu_hashStatus weu_hashSnapshot_getSlice(const weu_hashSnapshot *snapshot, weu_string key, const void **valueOut, uint32_t *valueLengthOut) {
+    return weu_hashSnapshot_getText(snapshot, key.text, key.length, valueOut, valueLengthOut);
+}
+weu_hashStatus weu_hashSnapshot_getInt(const weu_hashSnapshot *snapshot, uint64_t key, const void **valueOut, uint32_t *valueLengthOut) {
+    if (valueOut != NULL) *valueOut = NULL;
+    if (valueLengthOut != NULL) *valueLengthOut = 0;
+    if (snapshot == NULL) return WEU_HASH_INVALID;
+    const weu_hashSnapshotHeader *header = snapshot->header;
+    if (header->keyMode != WEU_HASHKEY_INT64 && (header->keyMode != WEU_HASHKEY_INT32 || key > UINT32_MAX)) return WEU_HASH_INVALID;
+    return _weu_hashSnapshot_find(snapshot, NULL, sizeof(uint64_t), weu_hash_int(key, header->seed), valueOut, valueLengthOut);
+}
 
 #endif
 #endif
\ No newline at end of file
@@ -17,12 +17,16 @@
 #define weu_master_h
 
 #include "weu_bitfield.h"
+#include "weu_charconv.h"
 #include "weu_coroutine.h"
 #include "weu_hashtable.h"
+#include "weu_hashcache.h"
 #include "weu_event.h"
 #include "weu_iobase.h"
 #include "weu_list.h"
 #include "weu_pair.h"
 #include "weu_string.h"
+#include "weu_stringpool.h"
+#include "weu_stringbuilder.h"
 
 #endif
\ No newline at end of file
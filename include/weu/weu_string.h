@@ -21,6 +21,7 @@
 #include "weu_datatypes.h"
 #include "weu_list.h"
 #include "weu_bitfield.h"
+#include "weu_charconv.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -48,7 +49,12 @@ WEUDEF weu_string *weu_string_copy(const weu_string *str);
 //  Printf will still print until original strings terminator.
 WEUDEF weu_string weu_string_slice(const weu_string *s, uint32_t from, uint32_t to);
 
+//  Sets length, text memory grows geometrically and is never shrunk by resize.
 WEUDEF void weu_string_resize(weu_string *s, uint32_t length, char emptyFill);
+//  Makes room for capacity characters without changing length.
+WEUDEF void weu_string_reserve(weu_string *s, uint32_t capacity);
+//  Frees unused capacity.
+WEUDEF void weu_string_shrinkToFit(weu_string *s);
 
 WEUDEF void weu_string_free(weu_string **data);
 WEUDEF void weu_string_datafreefun(void **data);
@@ -60,6 +66,90 @@ WEUDEF weu_stringNA weu_stringNA_new(const char *text);
 WEUDEF weu_stringNA weu_stringNA_newChar(char c);
 WEUDEF weu_stringNA weu_stringNA_newString(const weu_string *str);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SMALL STRING
+
+//  weu_stringSSO is passed by pointer and owns its text, it allocates only
+//  when text grows past WEU_STRINGSSO_CAPACITY characters.
+//  Every weu_stringSSO should be released with weu_stringSSO_free, inline ones included.
+//  Zero initialized weu_stringSSO is empty string.
+//  Text may move when string grows, pointers from weu_stringSSO_text are valid until next edit.
+//  Omitted on purpose - find, needles, line iterators, tokenizers, splitViews, condition checks and
+//  appends of numbers take weu_stringSSO_slice instead, pointer position, reserve, shrinkToFit,
+//  double formatting and weu_stringNA variants have no counterpart.
+
+WEUDEF weu_stringSSO weu_stringSSO_newSize(uint32_t length);
+WEUDEF weu_stringSSO weu_stringSSO_new(const char *text);
+WEUDEF weu_stringSSO weu_stringSSO_newText(const char *text, uint32_t length);
+WEUDEF weu_stringSSO weu_stringSSO_newChar(char c);
+WEUDEF weu_stringSSO weu_stringSSO_newString(const weu_string *str);
+WEUDEF weu_stringSSO weu_stringSSO_copy(const weu_stringSSO *s);
+//  Frees allocated text and leaves empty inline string.
+WEUDEF void weu_stringSSO_free(weu_stringSSO *s);
+
+WEUDEF uint32_t weu_stringSSO_length(const weu_stringSSO *s);
+WEUDEF bool weu_stringSSO_isInline(const weu_stringSSO *s);
+//  Null terminated text of string.
+WEUDEF const char *weu_stringSSO_text(const weu_stringSSO *s);
+WEUDEF char *weu_stringSSO_data(weu_stringSSO *s);
+//  Slice over text of string, same rules as weu_string_slice.
+WEUDEF weu_string weu_stringSSO_slice(const weu_stringSSO *s, uint32_t from, uint32_t to);
+WEUDEF weu_string *weu_stringSSO_toString(const weu_stringSSO *s);
+
+WEUDEF void weu_stringSSO_resize(weu_stringSSO *s, uint32_t length, char emptyFill);
+WEUDEF void weu_stringSSO_setText(weu_stringSSO *s, const char *text);
+
+WEUDEF bool weu_stringSSO_matches(const weu_stringSSO *s1, const weu_stringSSO *s2);
+WEUDEF bool weu_stringSSO_textMatches(const weu_stringSSO *s, const char *text);
+WEUDEF bool weu_stringSSO_containsText(const weu_stringSSO *s, const char *text);
+
+WEUDEF weu_stringSSO weu_stringSSO_fromTo(const weu_stringSSO *s, uint32_t from, uint32_t to);
+WEUDEF weu_stringSSO weu_stringSSO_cutFromTo(weu_stringSSO *s, uint32_t from, uint32_t to);
+WEUDEF void weu_stringSSO_removeFromTo(weu_stringSSO *s, uint32_t from, uint32_t to);
+WEUDEF void weu_stringSSO_overwriteFromTo(weu_stringSSO *s, uint32_t from, uint32_t to, const char *text);
+
+WEUDEF void weu_stringSSO_fill(weu_stringSSO *s, char fillChar, uint32_t from, uint32_t to);
+WEUDEF weu_stringSSO weu_stringSSO_filled(char fillChar, uint32_t len);
+
+WEUDEF void weu_stringSSO_concateText(weu_stringSSO *s, uint8_t count, ...);
+WEUDEF void weu_stringSSO_concateString(weu_stringSSO *s, uint8_t count, ...);
+WEUDEF void weu_stringSSO_concateStringSSO(weu_stringSSO *s, uint8_t count, ...);
+
+//  Returns line starting at *pos and moves *pos past its new line character.
+WEUDEF weu_stringSSO weu_stringSSO_getLine(const weu_stringSSO *s, uint32_t *pos);
+WEUDEF weu_stringSSO weu_stringSSO_cutLine(weu_stringSSO *s);
+
+//  Lists hold weu_stringSSO by value, tokens short enough stay inline. Token rules follow weu_string_splitByChar.
+WEUDEF weu_list *weu_stringSSO_splitByChar(const weu_stringSSO *s, char c);
+WEUDEF weu_list *weu_stringSSO_splitByText(const weu_stringSSO *s, const char *text);
+//  Destructor of lists holding weu_stringSSO by value.
+WEUDEF void weu_stringSSO_datafreefun(void **data);
+
+WEUDEF void weu_stringSSO_replaceChar(weu_stringSSO *s, char charToReplace, char newChar);
+WEUDEF weu_stringSSO weu_stringSSO_replacedChar(const weu_stringSSO *s, char charToReplace, char newChar);
+
+WEUDEF void weu_stringSSO_removeChars(weu_stringSSO *s, char charToRemove);
+WEUDEF void weu_stringSSO_removeCharsFromBeg(weu_stringSSO *s, char charToRemove);
+WEUDEF void weu_stringSSO_removeCharsFromEnd(weu_stringSSO *s, char charToRemove);
+WEUDEF weu_stringSSO weu_stringSSO_removedChars(const weu_stringSSO *s, char charToRemove);
+WEUDEF weu_stringSSO weu_stringSSO_removedCharsFromBeg(const weu_stringSSO *s, char charToRemove);
+WEUDEF weu_stringSSO weu_stringSSO_removedCharsFromEnd(const weu_stringSSO *s, char charToRemove);
+
+WEUDEF void weu_stringSSO_addIndent(weu_stringSSO *s, uint8_t count, uint8_t spaceCount);
+WEUDEF weu_stringSSO weu_stringSSO_addedIndent(const weu_stringSSO *s, uint8_t count, uint8_t spaceCount);
+WEUDEF void weu_stringSSO_removeIndent(weu_stringSSO *s);
+WEUDEF weu_stringSSO weu_stringSSO_removedIndent(const weu_stringSSO *s);
+
+//  Same rules as weu_string_parseInt, NULL string gives 0.
+WEUDEF int weu_stringSSO_parseInt(const weu_stringSSO *s);
+WEUDEF float weu_stringSSO_parseFloat(const weu_stringSSO *s);
+WEUDEF long long weu_stringSSO_parseLLong(const weu_stringSSO *s);
+
+WEUDEF weu_stringSSO weu_stringSSO_float(float val);
+WEUDEF weu_stringSSO weu_stringSSO_int(int32_t val);
+WEUDEF weu_stringSSO weu_stringSSO_uint(uint32_t val);
+WEUDEF weu_stringSSO weu_stringSSO_llong(int64_t val);
+WEUDEF weu_stringSSO weu_stringSSO_ullong(uint64_t val);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
 //  LENGTH
 
 WEUDEF uint32_t weu_string_stringLength(const weu_string *data);
@@ -67,6 +157,7 @@ WEUDEF uint32_t weu_string_textLength(const char *text);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  COMPARISON
 
+//  Strings of same length are compared by bytes, strings sharing text (pool canonical strings) by pointer.
 WEUDEF bool weu_string_matches(const weu_string *s1, const weu_string *s2);
 WEUDEF bool weu_stringNA_matches(const weu_stringNA s1, const weu_stringNA s2);
 WEUDEF bool weu_string_textMatches(const char *text1, const char *text2);
@@ -88,9 +179,27 @@ WEUDEF weu_stringNA weu_stringNA_textFromTo(const char *text, uint32_t from, uin
 WEUDEF void weu_string_removeFromTo(weu_string *s, uint32_t from, uint32_t to);
 WEUDEF void weu_string_overwriteFromTo(weu_string *s, uint32_t from, uint32_t to, const char *text);
 
+//  Searches from charPtrPos, moves charPtrPos to match or to end of string.
 WEUDEF bool weu_string_containsText(const weu_string *s, const char *text);
 WEUDEF bool weu_stringNA_containsText(const weu_stringNA *s, const char *text);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SEARCH
+//  Needles shorter than WEU_STRING_LONG_NEEDLE are found by comparing first and last needle byte
+//  at 16 (SSE2) or 32 (AVX2) positions at once and verifying candidates, longer needles
+//  skip through text with Boyer-Moore-Horspool bad character table.
+
+//  Returns position of first match at or after from, WEU_INDEX_INVALID if there is none.
+WEUDEF uint32_t weu_string_find(const weu_string *s, const char *text, uint32_t from);
+WEUDEF uint32_t weu_string_findText(const char *haystack, uint32_t haystackLen, const char *needle, uint32_t needleLen);
+//  Returns list of uint32_t positions of every match, overlapping matches included.
+WEUDEF weu_list *weu_string_findAll(const weu_string *s, const char *text);
+
+//  Compiled needle, worth it when same needle is searched for many times.
+WEUDEF weu_stringNeedle *weu_stringNeedle_new(const char *text, uint32_t length);
+WEUDEF void weu_stringNeedle_free(weu_stringNeedle **handle);
+WEUDEF uint32_t weu_stringNeedle_find(const weu_stringNeedle *needle, const char *haystack, uint32_t haystackLen, uint32_t from);
+WEUDEF weu_list *weu_stringNeedle_findAll(const weu_stringNeedle *needle, const char *haystack, uint32_t haystackLen);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
 //  STRING CHAR POINTER
 
 WEUDEF uint32_t weu_string_getPointerPos(const weu_string *s);
@@ -109,6 +218,15 @@ WEUDEF weu_stringNA weu_stringNA_filled(char fillChar, uint32_t len);
 WEUDEF void weu_string_concateString(weu_string *s, uint8_t count, ...);
 WEUDEF void weu_string_concateStringNA(weu_string *s, uint8_t count, ...);
 WEUDEF void weu_string_concateText(weu_string *s, uint8_t count, ...);
+//  Appends length bytes of text, reallocates only when capacity runs out.
+//  Text may point into s.
+WEUDEF void weu_string_append(weu_string *s, const char *text, uint32_t length);
+WEUDEF void weu_string_appendChar(weu_string *s, char c);
+//  Numbers are formatted straight into s with weu_charconv, same text as TO weu_string functions.
+WEUDEF void weu_string_appendInt(weu_string *s, int64_t val);
+WEUDEF void weu_string_appendUInt(weu_string *s, uint64_t val);
+WEUDEF void weu_string_appendFloat(weu_string *s, float val);
+WEUDEF void weu_string_appendDouble(weu_string *s, double val);
 
 WEUDEF weu_stringNA weu_stringNA_concatedString(uint8_t count, ...);
 WEUDEF weu_stringNA weu_stringNA_concatedStringNA(uint8_t count, ...);
@@ -119,13 +237,34 @@ WEUDEF weu_stringNA weu_stringNA_concatedText(uint8_t count, ...);
 WEUDEF weu_string *weu_string_getLine(const weu_string *s);
 WEUDEF weu_stringNA weu_string_getLineNA(const weu_string *s);
 
+//  Cut moves rest of text on every call, weu_stringLineIterator reads whole text in linear time.
 WEUDEF weu_string *weu_string_cutLine(weu_string *s);
 WEUDEF weu_stringNA weu_string_cutLineNA(weu_string *s);
+
+//  Iterates lines as slices from start of text without changing it, cost of iteration is linear.
+//  Last line does not need \n, text ending with \n has no empty line after it.
+WEUDEF weu_stringLineIterator weu_stringLineIterator_new(const char *text, uint32_t length, bool stripCR);
+WEUDEF weu_stringLineIterator weu_string_lines(const weu_string *s, bool stripCR);
+//  Returns false when there are no more lines, charPtrPos of line is its offset in text.
+WEUDEF bool weu_stringLineIterator_next(weu_stringLineIterator *it, weu_string *lineOut);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  SPLIT
 
+//  Lists hold weu_string* of every token, empty tokens between delimiters are kept,
+//  token after last delimiter is added only if it is not empty.
 WEUDEF weu_list *weu_string_splitByChar(const weu_string *s, char c);
 WEUDEF weu_list *weu_string_splitByText(const weu_string *s, const char *text);
+
+//  Tokenizers follow same token rules as split functions but yield slices of text, see weu_string_slice.
+//  Text must stay valid and unchanged while tokens are used.
+WEUDEF weu_stringTokenizer weu_stringTokenizer_new(const char *text, uint32_t length, char delimiter);
+WEUDEF weu_stringTokenizer weu_stringTokenizer_newText(const char *text, uint32_t length, const char *delimiter, uint32_t delimiterLength);
+//  Returns false when there are no more tokens, charPtrPos of token is its offset in text.
+WEUDEF bool weu_stringTokenizer_next(weu_stringTokenizer *t, weu_string *tokenOut);
+
+//  Fills out with up to maxCount slices of tokens and returns their count.
+//  When there are more tokens, last slice holds rest of text with its delimiters.
+WEUDEF uint32_t weu_string_splitViews(const weu_string *s, char delimiter, weu_string *out, uint32_t maxCount);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  CHAR REPLACE
 
@@ -159,7 +298,7 @@ WEUDEF weu_stringNA weu_stringNA_removeIndent(const weu_stringNA s);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  EXPRESSION
 
-/* varyingStringOut - if passed in created list, pushes variable strings to it
+/* varyingStringOut - if passed in created list of weu_string*, pushes copies of variable strings to it
 isMatching - if passed reference to bitfield_32 sets successful varying string test bits to 1
 
 #expression features
@@ -204,25 +343,73 @@ expression  - "test string %c[A-Z]%c[0-9] - %4s{ }[a-zA-Z0-9!a]"
 varying out - A, b, 1234, 0987, abF9d, a
 isMatching  - 1, 0, 1,    1,    0,     0
 */
+//  Parses expression while matching, use weu_expression_compile for repeated matching.
 WEUDEF bool weu_string_textMatchesExpression(const char *text, const char *expression, weu_list *varyingStringOut, weu_bitfield_32 *isMatching);
 WEUDEF bool weu_string_charMatchesCondition(const uint8_t c, const char *condition);
 WEUDEF bool weu_string_textMatchesCondition(const char *text, const char *condition);
+
+//  Expression compiled once, literals are split, repeat counts read and every condition
+//  is turned into weu_charClass, so matching tests each character with one bit lookup.
+//  Returns NULL when % is not followed by c or s.
+WEUDEF weu_expression *weu_expression_compile(const char *expression);
+WEUDEF void weu_expression_free(weu_expression **handle);
+//  Matches length bytes of text, same result as weu_string_textMatchesExpression, except
+//  string end character found in text is skipped in expression only when literal
+//  following string starts with it, so repeated strings may be followed by literal.
+//  varyingOut - NULL or array of varyingCount slices of text, filled without allocation,
+//               tests text ran out before get empty slices
+WEUDEF bool weu_expression_match(const weu_expression *e, const char *text, uint32_t length, weu_string *varyingOut, weu_bitfield_32 *isMatching);
+
+//  condition - [a-z!0-9] syntax with or without brackets, empty condition accepts every character
+WEUDEF weu_charClass weu_charClass_new(const char *condition);
+//  Class of exactly length bytes of chars.
+WEUDEF weu_charClass weu_charClass_fromChars(const char *chars, uint32_t length);
+WEUDEF bool weu_charClass_contains(const weu_charClass *c, uint8_t ch);
+//  Scanning functions test 32 or 16 bytes per step with AVX2 or SSSE3 nibble lookup,
+//  byte by byte without them.
+//  Returns true when every byte of text is in class, also for empty text.
+WEUDEF bool weu_charClass_all(const weu_charClass *c, const char *text, uint32_t length);
+//  Returns position of first byte at or after from that is in class, WEU_INDEX_INVALID if none.
+WEUDEF uint32_t weu_charClass_find(const weu_charClass *c, const char *text, uint32_t length, uint32_t from);
+//  Returns position of first byte at or after from that is not in class, WEU_INDEX_INVALID if none.
+WEUDEF uint32_t weu_charClass_findNot(const weu_charClass *c, const char *text, uint32_t length, uint32_t from);
+WEUDEF uint32_t weu_charClass_count(const weu_charClass *c, const char *text, uint32_t length);
+
+//  Set of expressions matched together against one text. Literals of all patterns are found
+//  in single Aho-Corasick pass over text, only patterns whose every literal occurs in text
+//  are matched with weu_expression_match, so cost follows text length, not pattern count.
+//  Returns NULL when any expression does not compile.
+WEUDEF weu_expressionSet *weu_expressionSet_new(const char **expressions, uint32_t count);
+WEUDEF void weu_expressionSet_free(weu_expressionSet **handle);
+//  Returns count of patterns matching length bytes of text. Set keeps scratch state,
+//  so one set must not be matched from several threads at once.
+//  idsOut      - NULL or array of patternCount ids, matching ids are written in ascending order
+//  capturesOut - NULL or array of captureCount slices, captures of pattern id are written
+//                from captureOffsets[id], slices of patterns not matching are undefined
+WEUDEF uint32_t weu_expressionSet_match(weu_expressionSet *set, const char *text, uint32_t length, uint32_t *idsOut, weu_string *capturesOut);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PARSE
 
+//  Parse terminated text, skipping leading white space like atoi, without locale.
+//  Text that is not number gives 0, out of range integers are clamped.
+//  weu_charconv parse functions report errors and bytes read.
 WEUDEF int weu_string_parseInt(const char *text);
 WEUDEF float weu_string_parseFloat(const char *text);
 WEUDEF long long weu_string_parseLLong(const char *text);
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  TO weu_string
+//  Integers are written in decimal, floats with shortest digits that read back to same value,
+//  see weu_charconv.h. Text can be written to caller buffer with weu_charconv_format functions.
 
 WEUDEF weu_string *weu_string_float(float val);
+WEUDEF weu_string *weu_string_double(double val);
 WEUDEF weu_string *weu_string_int(int32_t val);
 WEUDEF weu_string *weu_string_uint(uint32_t val);
 WEUDEF weu_string *weu_string_llong(int64_t val);
 WEUDEF weu_string *weu_string_ullong(uint64_t val);
 
 WEUDEF weu_stringNA weu_string_floatNA(float val);
+WEUDEF weu_stringNA weu_string_doubleNA(double val);
 WEUDEF weu_stringNA weu_string_intNA(int32_t val);
 WEUDEF weu_stringNA weu_string_uintNA(uint32_t val);
 WEUDEF weu_stringNA weu_string_llongNA(int64_t val);
@@ -236,6 +423,168 @@ WEUDEF void weu_string_printText(int count, ...);
 
 #define INVALID 0xffffffff
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTERNAL
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define WEU_STRING_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WEU_STRING_SSE2
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define WEU_STRING_SSSE3
+#endif
+
+#ifndef WEU_STRING_LONG_NEEDLE
+#define WEU_STRING_LONG_NEEDLE 256
+#endif
+
+static inline uint32_t _weu_string_ctz(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#else
+    uint32_t out = 0;
+    while (!(x & 1)) { x >>= 1; ++out; }
+    return out;
+#endif
+}
+static inline uint32_t _weu_string_popcount(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcount(x);
+#else
+    uint32_t out = 0;
+    for (; x != 0; x &= x - 1) ++out;
+    return out;
+#endif
+}
+static inline uint32_t _weu_string_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(x);
+#else
+    return (uint32_t)x != 0 ? _weu_string_ctz((uint32_t)x) : 32 + _weu_string_ctz((uint32_t)(x >> 32));
+#endif
+}
+//  Returns position of first c at or after from, textLen if there is none.
+//  Long runs without c are scanned 64 bytes per step.
+static inline uint32_t _weu_string_findChar(const char *text, uint32_t textLen, char c, uint32_t from) {
+    uint32_t i = from;
+#ifdef WEU_STRING_AVX2
+    const __m256i c32 = _mm256_set1_epi8(c);
+    for (; i + 64 <= textLen; i += 64) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(text + i)), c32);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(text + i + 32)), c32);
+        if (_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) continue;
+        uint64_t mask = (uint32_t)_mm256_movemask_epi8(a) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(b) << 32);
+        return i + _weu_string_ctz64(mask);
+    }
+#endif
+#ifdef WEU_STRING_SSE2
+    const __m128i c16 = _mm_set1_epi8(c);
+    for (; i + 64 <= textLen; i += 64) {
+        __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(text + i)), c16);
+        __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(text + i + 16)), c16);
+        __m128i d = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(text + i + 32)), c16);
+        __m128i e = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(text + i + 48)), c16);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(d, e))) == 0) continue;
+        uint64_t mask = (uint64_t)(uint32_t)_mm_movemask_epi8(a)         | ((uint64_t)(uint32_t)_mm_movemask_epi8(b) << 16) |
+                        ((uint64_t)(uint32_t)_mm_movemask_epi8(d) << 32) | ((uint64_t)(uint32_t)_mm_movemask_epi8(e) << 48);
+        return i + _weu_string_ctz64(mask);
+    }
+    for (; i + 16 <= textLen; i += 16) {
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(text + i)), c16));
+        if (mask != 0) return i + _weu_string_ctz(mask);
+    }
+#endif
+    for (; i < textLen; i++) {
+        if (text[i] == c) return i;
+    }
+    return textLen;
+}
+//  Candidates are positions where first and last needle byte match, middle bytes are then compared.
+//  needleLen is at least 2 and not above textLen.
+static uint32_t _weu_string_searchFilter(const uint8_t *text, uint32_t textLen, const uint8_t *needle, uint32_t needleLen) {
+    uint32_t end = textLen - needleLen + 1;
+    uint32_t i = 0;
+#ifdef WEU_STRING_AVX2
+    const __m256i first32 = _mm256_set1_epi8((char)needle[0]);
+    const __m256i last32  = _mm256_set1_epi8((char)needle[needleLen - 1]);
+    for (; i + 32 <= end; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(text + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(text + i + needleLen - 1));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first32), _mm256_cmpeq_epi8(b, last32)));
+        for (; mask != 0; mask &= mask - 1) {
+            uint32_t pos = i + _weu_string_ctz(mask);
+            if (memcmp(text + pos + 1, needle + 1, needleLen - 2) == 0) return pos;
+        }
+    }
+#endif
+#ifdef WEU_STRING_SSE2
+    const __m128i first16 = _mm_set1_epi8((char)needle[0]);
+    const __m128i last16  = _mm_set1_epi8((char)needle[needleLen - 1]);
+    for (; i + 16 <= end; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(text + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(text + i + needleLen - 1));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first16), _mm_cmpeq_epi8(b, last16)));
+        for (; mask != 0; mask &= mask - 1) {
+            uint32_t pos = i + _weu_string_ctz(mask);
+            if (memcmp(text + pos + 1, needle + 1, needleLen - 2) == 0) return pos;
+        }
+    }
+#endif
+    for (; i < end; i++) {
+        if (text[i] == needle[0] && text[i + needleLen - 1] == needle[needleLen - 1] &&
+            memcmp(text + i + 1, needle + 1, needleLen - 2) == 0) return i;
+    }
+    return WEU_INDEX_INVALID;
+}
+static void _weu_string_shiftTable(const uint8_t *needle, uint32_t needleLen, uint32_t *shift) {
+    for (uint32_t i = 0; i < 256; i++) shift[i] = needleLen;
+    for (uint32_t i = 0; i + 1 < needleLen; i++) shift[needle[i]] = needleLen - 1 - i;
+}
+static uint32_t _weu_string_searchHorspool(const uint8_t *text, uint32_t textLen, const uint8_t *needle, uint32_t needleLen, const uint32_t *shift) {
+    uint8_t last = needle[needleLen - 1];
+    for (uint32_t i = 0; i + needleLen <= textLen;) {
+        uint8_t c = text[i + needleLen - 1];
+        if (c == last && memcmp(text + i, needle, needleLen - 1) == 0) return i;
+        i += shift[c];
+    }
+    return WEU_INDEX_INVALID;
+}
+//  Returns position of needle in text, shift table is built on stack for long needles when NULL.
+static uint32_t _weu_string_search(const char *text, uint32_t textLen, const char *needle, uint32_t needleLen, const uint32_t *shift) {
+    if (needleLen == 0) return 0;
+    if (needleLen > textLen) return WEU_INDEX_INVALID;
+    if (needleLen == 1) {
+        const char *match = (const char*)memchr(text, needle[0], textLen);
+        return match != NULL ? (uint32_t)(match - text) : WEU_INDEX_INVALID;
+    }
+    if (needleLen < WEU_STRING_LONG_NEEDLE) return _weu_string_searchFilter((const uint8_t*)text, textLen, (const uint8_t*)needle, needleLen);
+    uint32_t table[256];
+    if (shift == NULL) {
+        _weu_string_shiftTable((const uint8_t*)needle, needleLen, table);
+        shift = table;
+    }
+    return _weu_string_searchHorspool((const uint8_t*)text, textLen, (const uint8_t*)needle, needleLen, shift);
+}
+static uint32_t _weu_string_searchFrom(const char *text, uint32_t textLen, const char *needle, uint32_t needleLen, const uint32_t *shift, uint32_t from) {
+    if (from > textLen) return WEU_INDEX_INVALID;
+    uint32_t pos = _weu_string_search(text + from, textLen - from, needle, needleLen, shift);
+    return pos == WEU_INDEX_INVALID ? pos : pos + from;
+}
+static weu_list *_weu_string_searchAll(const char *text, uint32_t textLen, const char *needle, uint32_t needleLen, const uint32_t *shift) {
+    weu_list *out = weu_list_new(8, sizeof(uint32_t), NULL);
+    if (needleLen == 0) return out;
+    for (uint32_t pos = 0; (pos = _weu_string_searchFrom(text, textLen, needle, needleLen, shift, pos)) != WEU_INDEX_INVALID; pos++) {
+        weu_list_push(out, &pos);
+    }
+    return out;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  ALLOCATION
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -244,6 +593,7 @@ weu_string *weu_string_newSize(uint32_t length) {
     weu_string *out     = (weu_string*)malloc(sizeof(weu_string));
     out->length         = length;
     out->allocLength    = length;
+    out->charPtrPos     = 0;
     out->text           = (char*)calloc(length + 1, 1);
     out->text[length]   = '\0';
     return out;
@@ -273,15 +623,33 @@ weu_string weu_string_slice(const weu_string *s, uint32_t from, uint32_t to) {
     return (weu_string){.allocLength = 0, .charPtrPos = from, .length = to - from, .text = s->text + from};
 }
 
+//  Grows capacity to at least length, at least doubling it so repeated growth is amortized.
+static void _weu_string_grow(weu_string *s, uint32_t length) {
+    if (length <= s->allocLength) return;
+    uint32_t capacity = s->allocLength < 8 ? 8 : s->allocLength;
+    while (capacity < length) capacity = capacity > UINT32_MAX / 2 ? length : capacity * 2;
+    s->text = (char*)realloc(s->text, (size_t)capacity + 1);
+    s->allocLength = capacity;
+}
 void weu_string_resize(weu_string *s, uint32_t length, char emptyFill) {
-    s->text = (char*)realloc(s->text, length + 1);
+    if (s == NULL) return;
+    _weu_string_grow(s, length);
     if (s->length < length) {
         memset(s->text + s->length, emptyFill, length - s->length);
     }
     s->length = length;
-    s->allocLength = length;
     s->text[length] = '\0'; 
 }
+void weu_string_reserve(weu_string *s, uint32_t capacity) {
+    if (s == NULL || capacity <= s->allocLength) return;
+    s->text = (char*)realloc(s->text, (size_t)capacity + 1);
+    s->allocLength = capacity;
+}
+void weu_string_shrinkToFit(weu_string *s) {
+    if (s == NULL || s->allocLength == s->length) return;
+    s->text = (char*)realloc(s->text, (size_t)s->length + 1);
+    s->allocLength = s->length;
+}
 
 void weu_string_free(weu_string **data) {
     if (*data == NULL) return;
@@ -331,6 +699,382 @@ weu_stringNA weu_stringNA_newString(const weu_string *str) {
     return out;
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SMALL STRING
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline bool _weu_stringSSO_isHeap(const weu_stringSSO *s) {
+    return (uint8_t)s->small[WEU_STRINGSSO_CAPACITY + 1] == WEU_STRINGSSO_HEAP;
+}
+static inline char *_weu_stringSSO_text(weu_stringSSO *s) {
+    return _weu_stringSSO_isHeap(s) ? s->large.text : s->small;
+}
+static inline void _weu_stringSSO_setLength(weu_stringSSO *s, uint32_t length) {
+    if (_weu_stringSSO_isHeap(s)) {
+        s->large.length = length;
+        s->large.text[length] = '\0';
+    } else {
+        s->small[length] = '\0';
+        s->small[WEU_STRINGSSO_CAPACITY + 1] = (char)length;
+    }
+}
+//  Makes room for capacity characters, allocated capacity at least doubles so appends are amortized.
+static void _weu_stringSSO_reserve(weu_stringSSO *s, uint32_t capacity) {
+    if (_weu_stringSSO_isHeap(s)) {
+        if (capacity <= s->large.capacity) return;
+        if (capacity < s->large.capacity * 2) capacity = s->large.capacity * 2;
+        s->large.text = (char*)realloc(s->large.text, capacity + 1);
+        s->large.capacity = capacity;
+        return;
+    }
+    if (capacity <= WEU_STRINGSSO_CAPACITY) return;
+    if (capacity < WEU_STRINGSSO_CAPACITY * 2) capacity = WEU_STRINGSSO_CAPACITY * 2;
+    uint32_t length = (uint8_t)s->small[WEU_STRINGSSO_CAPACITY + 1];
+    char *text = (char*)malloc(capacity + 1);
+    memcpy(text, s->small, length + 1);
+    s->large.text       = text;
+    s->large.length     = length;
+    s->large.capacity   = capacity;
+    s->large.tag        = WEU_STRINGSSO_HEAP;
+}
+static inline void _weu_stringSSO_clamp(uint32_t length, uint32_t *from, uint32_t *to) {
+    if (*from > *to) { uint32_t temp; SWAPVAR(*from, *to, temp); }
+    if (*to > length) *to = length;
+    if (*from > *to) *from = *to;
+}
+
+weu_stringSSO weu_stringSSO_newSize(uint32_t length) {
+    weu_stringSSO out = {{0}};
+    _weu_stringSSO_reserve(&out, length);
+    memset(_weu_stringSSO_text(&out), 0, length);
+    _weu_stringSSO_setLength(&out, length);
+    return out;
+}
+weu_stringSSO weu_stringSSO_new(const char *text) {
+    return weu_stringSSO_newText(text, text != NULL ? (uint32_t)strlen(text) : 0);
+}
+weu_stringSSO weu_stringSSO_newText(const char *text, uint32_t length) {
+    weu_stringSSO out = {{0}};
+    if (text == NULL) length = 0;
+    _weu_stringSSO_reserve(&out, length);
+    if (length > 0) memcpy(_weu_stringSSO_text(&out), text, length);
+    _weu_stringSSO_setLength(&out, length);
+    return out;
+}
+weu_stringSSO weu_stringSSO_newChar(char c) {
+    return weu_stringSSO_newText(&c, 1);
+}
+weu_stringSSO weu_stringSSO_newString(const weu_string *str) {
+    if (str == NULL) return weu_stringSSO_newText(NULL, 0);
+    return weu_stringSSO_newText(str->text, str->length);
+}
+weu_stringSSO weu_stringSSO_copy(const weu_stringSSO *s) {
+    if (s == NULL) return weu_stringSSO_newText(NULL, 0);
+    if (!_weu_stringSSO_isHeap(s)) return *s;
+    return weu_stringSSO_newText(s->large.text, s->large.length);
+}
+void weu_stringSSO_free(weu_stringSSO *s) {
+    if (s == NULL) return;
+    if (_weu_stringSSO_isHeap(s)) free(s->large.text);
+    memset(s, 0, sizeof(weu_stringSSO));
+}
+
+uint32_t weu_stringSSO_length(const weu_stringSSO *s) {
+    if (s == NULL) return 0;
+    return _weu_stringSSO_isHeap(s) ? s->large.length : (uint8_t)s->small[WEU_STRINGSSO_CAPACITY + 1];
+}
+bool weu_stringSSO_isInline(const weu_stringSSO *s) {
+    return s != NULL && !_weu_stringSSO_isHeap(s);
+}
+const char *weu_stringSSO_text(const weu_stringSSO *s) {
+    if (s == NULL) return NULL;
+    return _weu_stringSSO_isHeap(s) ? s->large.text : s->small;
+}
+char *weu_stringSSO_data(weu_stringSSO *s) {
+    if (s == NULL) return NULL;
+    return _weu_stringSSO_text(s);
+}
+weu_string weu_stringSSO_slice(const weu_stringSSO *s, uint32_t from, uint32_t to) {
+    if (s == NULL) return (weu_string){0};
+    _weu_stringSSO_clamp(weu_stringSSO_length(s), &from, &to);
+    return (weu_string){.allocLength = 0, .charPtrPos = from, .length = to - from, .text = (char*)weu_stringSSO_text(s) + from};
+}
+weu_string *weu_stringSSO_toString(const weu_stringSSO *s) {
+    if (s == NULL) return NULL;
+    uint32_t length = weu_stringSSO_length(s);
+    weu_string *out = weu_string_newSize(length);
+    memcpy(out->text, weu_stringSSO_text(s), length);
+    return out;
+}
+
+void weu_stringSSO_resize(weu_stringSSO *s, uint32_t length, char emptyFill) {
+    if (s == NULL) return;
+    uint32_t oldLength = weu_stringSSO_length(s);
+    _weu_stringSSO_reserve(s, length);
+    if (oldLength < length) memset(_weu_stringSSO_text(s) + oldLength, emptyFill, length - oldLength);
+    _weu_stringSSO_setLength(s, length);
+}
+void weu_stringSSO_setText(weu_stringSSO *s, const char *text) {
+    if (s == NULL) return;
+    uint32_t length = text != NULL ? (uint32_t)strlen(text) : 0;
+    _weu_stringSSO_reserve(s, length);
+    memmove(_weu_stringSSO_text(s), text != NULL ? text : "", length);
+    _weu_stringSSO_setLength(s, length);
+}
+
+bool weu_stringSSO_matches(const weu_stringSSO *s1, const weu_stringSSO *s2) {
+    if (s1 == NULL || s2 == NULL) return false;
+    uint32_t length = weu_stringSSO_length(s1);
+    if (length != weu_stringSSO_length(s2)) return false;
+    return memcmp(weu_stringSSO_text(s1), weu_stringSSO_text(s2), length) == 0;
+}
+bool weu_stringSSO_textMatches(const weu_stringSSO *s, const char *text) {
+    if (s == NULL || text == NULL) return false;
+    return strcmp(weu_stringSSO_text(s), text) == 0;
+}
+bool weu_stringSSO_containsText(const weu_stringSSO *s, const char *text) {
+    if (s == NULL || text == NULL) return false;
+    return _weu_string_search(weu_stringSSO_text(s), weu_stringSSO_length(s), text, (uint32_t)strlen(text), NULL) != WEU_INDEX_INVALID;
+}
+
+weu_stringSSO weu_stringSSO_fromTo(const weu_stringSSO *s, uint32_t from, uint32_t to) {
+    weu_string slice = weu_stringSSO_slice(s, from, to);
+    return weu_stringSSO_newText(slice.text, slice.length);
+}
+weu_stringSSO weu_stringSSO_cutFromTo(weu_stringSSO *s, uint32_t from, uint32_t to) {
+    weu_stringSSO out = weu_stringSSO_fromTo(s, from, to);
+    weu_stringSSO_removeFromTo(s, from, to);
+    return out;
+}
+void weu_stringSSO_removeFromTo(weu_stringSSO *s, uint32_t from, uint32_t to) {
+    if (s == NULL) return;
+    uint32_t length = weu_stringSSO_length(s);
+    _weu_stringSSO_clamp(length, &from, &to);
+    char *text = _weu_stringSSO_text(s);
+    memmove(text + from, text + to, length - to);
+    _weu_stringSSO_setLength(s, length - (to - from));
+}
+void weu_stringSSO_overwriteFromTo(weu_stringSSO *s, uint32_t from, uint32_t to, const char *text) {
+    if (s == NULL || text == NULL) return;
+    _weu_stringSSO_clamp(weu_stringSSO_length(s), &from, &to);
+    uint32_t length = (uint32_t)strlen(text);
+    memcpy(_weu_stringSSO_text(s) + from, text, to - from < length ? to - from : length);
+}
+
+void weu_stringSSO_fill(weu_stringSSO *s, char fillChar, uint32_t from, uint32_t to) {
+    if (s == NULL) return;
+    if (from > to) { uint32_t temp; SWAPVAR(from, to, temp); }
+    if (to > weu_stringSSO_length(s)) weu_stringSSO_resize(s, to, ' ');
+    memset(_weu_stringSSO_text(s) + from, fillChar, to - from);
+}
+weu_stringSSO weu_stringSSO_filled(char fillChar, uint32_t len) {
+    weu_stringSSO out = weu_stringSSO_newText(NULL, 0);
+    weu_stringSSO_resize(&out, len, fillChar);
+    return out;
+}
+
+static void _weu_stringSSO_append(weu_stringSSO *s, const char *text, uint32_t length) {
+    uint32_t oldLength = weu_stringSSO_length(s);
+    //  Text inside s moves with it when s grows or leaves inline storage
+    const char *old = _weu_stringSSO_text(s);
+    uint32_t capacity = _weu_stringSSO_isHeap(s) ? s->large.capacity : WEU_STRINGSSO_CAPACITY;
+    bool inside = text >= old && text <= old + capacity;
+    size_t offset = inside ? (size_t)(text - old) : 0;
+    _weu_stringSSO_reserve(s, oldLength + length);
+    if (inside) text = _weu_stringSSO_text(s) + offset;
+    memmove(_weu_stringSSO_text(s) + oldLength, text, length);
+    _weu_stringSSO_setLength(s, oldLength + length);
+}
+void weu_stringSSO_concateText(weu_stringSSO *s, uint8_t count, ...) {
+    if (s == NULL) return;
+    va_list args;
+    va_start(args, count);
+    for (int i = 0; i < count; i++)
+    {
+        const char *text = va_arg(args, const char*);
+        if (text == NULL) continue;
+        _weu_stringSSO_append(s, text, (uint32_t)strlen(text));
+    }
+    va_end(args);
+}
+void weu_stringSSO_concateString(weu_stringSSO *s, uint8_t count, ...) {
+    if (s == NULL) return;
+    va_list args;
+    va_start(args, count);
+    for (int i = 0; i < count; i++)
+    {
+        const weu_string *str = va_arg(args, const weu_string*);
+        if (str == NULL) continue;
+        _weu_stringSSO_append(s, str->text, str->length);
+    }
+    va_end(args);
+}
+void weu_stringSSO_concateStringSSO(weu_stringSSO *s, uint8_t count, ...) {
+    if (s == NULL) return;
+    va_list args;
+    va_start(args, count);
+    for (int i = 0; i < count; i++)
+    {
+        const weu_stringSSO *str = va_arg(args, const weu_stringSSO*);
+        if (str == NULL) continue;
+        if (str == s) {
+            //  Appending to itself, text may move while growing
+            uint32_t length = weu_stringSSO_length(s);
+            _weu_stringSSO_reserve(s, length * 2);
+            memcpy(_weu_stringSSO_text(s) + length, _weu_stringSSO_text(s), length);
+            _weu_stringSSO_setLength(s, length * 2);
+            continue;
+        }
+        _weu_stringSSO_append(s, weu_stringSSO_text(str), weu_stringSSO_length(str));
+    }
+    va_end(args);
+}
+
+weu_stringSSO weu_stringSSO_getLine(const weu_stringSSO *s, uint32_t *pos) {
+    if (s == NULL || pos == NULL) return weu_stringSSO_newText(NULL, 0);
+    uint32_t length = weu_stringSSO_length(s);
+    uint32_t start = *pos < length ? *pos : length;
+    const char *text = weu_stringSSO_text(s);
+    const char *end = (const char*)memchr(text + start, '\n', length - start);
+    uint32_t lineEnd = end != NULL ? (uint32_t)(end - text) : length;
+    *pos = lineEnd + (end != NULL);
+    return weu_stringSSO_newText(text + start, lineEnd - start);
+}
+weu_stringSSO weu_stringSSO_cutLine(weu_stringSSO *s) {
+    uint32_t pos = 0;
+    weu_stringSSO out = weu_stringSSO_getLine(s, &pos);
+    weu_stringSSO_removeFromTo(s, 0, pos);
+    return out;
+}
+
+static weu_list *_weu_stringSSO_split(weu_stringTokenizer *t) {
+    weu_list *out = weu_list_new(8, sizeof(weu_stringSSO), weu_stringSSO_datafreefun);
+    weu_string token;
+    while (weu_stringTokenizer_next(t, &token)) {
+        weu_stringSSO piece = weu_stringSSO_newText(token.text, token.length);
+        weu_list_push(out, &piece);
+    }
+    return out;
+}
+weu_list *weu_stringSSO_splitByChar(const weu_stringSSO *s, char c) {
+    if (s == NULL) return NULL;
+    weu_stringTokenizer t = weu_stringTokenizer_new(weu_stringSSO_text(s), weu_stringSSO_length(s), c);
+    return _weu_stringSSO_split(&t);
+}
+weu_list *weu_stringSSO_splitByText(const weu_stringSSO *s, const char *text) {
+    if (s == NULL || text == NULL) return NULL;
+    weu_stringTokenizer t = weu_stringTokenizer_newText(weu_stringSSO_text(s), weu_stringSSO_length(s), text, (uint32_t)strlen(text));
+    return _weu_stringSSO_split(&t);
+}
+void weu_stringSSO_datafreefun(void **data) {
+    weu_stringSSO_free((weu_stringSSO*)data);
+}
+
+void weu_stringSSO_replaceChar(weu_stringSSO *s, char charToReplace, char newChar) {
+    if (s == NULL) return;
+    char *text = _weu_stringSSO_text(s);
+    uint32_t length = weu_stringSSO_length(s);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (text[i] == charToReplace) text[i] = newChar;
+    }
+}
+weu_stringSSO weu_stringSSO_replacedChar(const weu_stringSSO *s, char charToReplace, char newChar) {
+    weu_stringSSO out = weu_stringSSO_copy(s);
+    weu_stringSSO_replaceChar(&out, charToReplace, newChar);
+    return out;
+}
+void weu_stringSSO_removeChars(weu_stringSSO *s, char charToRemove) {
+    if (s == NULL) return;
+    char *text = _weu_stringSSO_text(s);
+    uint32_t length = weu_stringSSO_length(s), newLength = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (text[i] != charToRemove) text[newLength++] = text[i];
+    }
+    _weu_stringSSO_setLength(s, newLength);
+}
+void weu_stringSSO_removeCharsFromBeg(weu_stringSSO *s, char charToRemove) {
+    if (s == NULL) return;
+    const char *text = weu_stringSSO_text(s);
+    uint32_t length = weu_stringSSO_length(s), start = 0;
+    while (start < length && text[start] == charToRemove) ++start;
+    weu_stringSSO_removeFromTo(s, 0, start);
+}
+void weu_stringSSO_removeCharsFromEnd(weu_stringSSO *s, char charToRemove) {
+    if (s == NULL) return;
+    const char *text = weu_stringSSO_text(s);
+    uint32_t length = weu_stringSSO_length(s);
+    while (length > 0 && text[length - 1] == charToRemove) --length;
+    _weu_stringSSO_setLength(s, length);
+}
+weu_stringSSO weu_stringSSO_removedChars(const weu_stringSSO *s, char charToRemove) {
+    weu_stringSSO out = weu_stringSSO_copy(s);
+    weu_stringSSO_removeChars(&out, charToRemove);
+    return out;
+}
+weu_stringSSO weu_stringSSO_removedCharsFromBeg(const weu_stringSSO *s, char charToRemove) {
+    weu_stringSSO out = weu_stringSSO_copy(s);
+    weu_stringSSO_removeCharsFromBeg(&out, charToRemove);
+    return out;
+}
+weu_stringSSO weu_stringSSO_removedCharsFromEnd(const weu_stringSSO *s, char charToRemove) {
+    weu_stringSSO out = weu_stringSSO_copy(s);
+    weu_stringSSO_removeCharsFromEnd(&out, charToRemove);
+    return out;
+}
+
+void weu_stringSSO_addIndent(weu_stringSSO *s, uint8_t count, uint8_t spaceCount) {
+    if (s == NULL) return;
+    uint32_t tabLen = count * spaceCount;
+    uint32_t oldLength = weu_stringSSO_length(s);
+    weu_stringSSO_resize(s, oldLength + tabLen, ' ');
+    char *text = _weu_stringSSO_text(s);
+    memmove(text + tabLen, text, oldLength);
+    memset(text, ' ', tabLen);
+}
+weu_stringSSO weu_stringSSO_addedIndent(const weu_stringSSO *s, uint8_t count, uint8_t spaceCount) {
+    weu_stringSSO out = weu_stringSSO_copy(s);
+    weu_stringSSO_addIndent(&out, count, spaceCount);
+    return out;
+}
+void weu_stringSSO_removeIndent(weu_stringSSO *s) {
+    weu_stringSSO_removeCharsFromBeg(s, ' ');
+}
+weu_stringSSO weu_stringSSO_removedIndent(const weu_stringSSO *s) {
+    return weu_stringSSO_removedCharsFromBeg(s, ' ');
+}
+
+int weu_stringSSO_parseInt(const weu_stringSSO *s) {
+    return s != NULL ? weu_string_parseInt(weu_stringSSO_text(s)) : 0;
+}
+float weu_stringSSO_parseFloat(const weu_stringSSO *s) {
+    return s != NULL ? weu_string_parseFloat(weu_stringSSO_text(s)) : 0.0f;
+}
+long long weu_stringSSO_parseLLong(const weu_stringSSO *s) {
+    return s != NULL ? weu_string_parseLLong(weu_stringSSO_text(s)) : 0;
+}
+
+weu_stringSSO weu_stringSSO_float(float val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    return weu_stringSSO_newText(buffer, weu_charconv_formatFloat(buffer, val));
+}
+weu_stringSSO weu_stringSSO_int(int32_t val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    return weu_stringSSO_newText(buffer, weu_charconv_formatInt(buffer, val));
+}
+weu_stringSSO weu_stringSSO_uint(uint32_t val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    return weu_stringSSO_newText(buffer, weu_charconv_formatUInt(buffer, val));
+}
+weu_stringSSO weu_stringSSO_llong(int64_t val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    return weu_stringSSO_newText(buffer, weu_charconv_formatInt(buffer, val));
+}
+weu_stringSSO weu_stringSSO_ullong(uint64_t val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    return weu_stringSSO_newText(buffer, weu_charconv_formatUInt(buffer, val));
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
 //  LENGTH
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -347,12 +1091,13 @@ uint32_t weu_string_textLength(const char *text) {
 
 bool weu_string_matches(const weu_string *s1, const weu_string *s2) {
     if (s1 == NULL || s2 == NULL) return 0;
+    if (s1 == s2 || s1->text == s2->text) return s1->length == s2->length;
     if (s1->length != s2->length) return 0;
-    return strcmp(s1->text, s2->text) == 0 ? 1 : 0;
+    return memcmp(s1->text, s2->text, s1->length) == 0 ? 1 : 0;
 }
 bool weu_stringNA_matches(const weu_stringNA s1, const weu_stringNA s2) {
     if (s1.length != s2.length) return 0;
-     return strcmp(s1.text, s2.text) == 0 ? 1 : 0;
+    return memcmp(s1.text, s2.text, s1.length) == 0 ? 1 : 0;
 }
 bool weu_string_textMatches(const char *text1, const char *text2) {
     if (!text1 || !text2) return false;
@@ -364,11 +1109,8 @@ bool weu_string_textMatches(const char *text1, const char *text2) {
 
 void weu_string_setText(weu_string *s, const char *text) {
     if (s == NULL) return;
-    int len = weu_string_textLength(text);
-    s->length = len;
-    s->text = (char*)realloc(s->text, len + 1);
-    memcpy(s->text, text, len);
-    s->text[len] = '\0';
+    s->length = 0;
+    weu_string_append(s, text, weu_string_textLength(text));
 }
 void weu_string_setTextNA(weu_stringNA *s, const char *text) {
     if (s == NULL) return;
@@ -463,53 +1205,57 @@ void weu_string_overwriteFromTo(weu_string *s, uint32_t from, uint32_t to, const
 
 bool weu_string_containsText(const weu_string *s, const char *text) {
     if (s == NULL || text == NULL) return false;
-    bool contains = false;
-    uint32_t textLen = weu_string_textLength(text);
-    uint32_t pos = s->charPtrPos;
-    for (; pos < s->length; pos++)
-    {
-        if ( s->text[pos] == text[0] ) {
-            uint32_t i = 1;
-            for (; i < textLen; i++)
-            {
-                if (s->text[pos + i] != text[i]) {
-                    pos += i;
-                    i = INVALID;
-                    break;
-                }
-            }
-            if (i != INVALID) { 
-                contains = true;
-                break;
-            };
-        }
-    }
-    ((weu_string*)s)->charPtrPos = pos;
-    return contains;
+    uint32_t pos = _weu_string_searchFrom(s->text, s->length, text, (uint32_t)strlen(text), NULL, s->charPtrPos);
+    ((weu_string*)s)->charPtrPos = pos != WEU_INDEX_INVALID ? pos : s->length;
+    return pos != WEU_INDEX_INVALID;
 }
 bool weu_stringNA_containsText(const weu_stringNA *s, const char *text) {
     if (s == NULL || text == NULL) return false;
-    bool contains = false;
-    uint32_t textLen = weu_string_textLength(text);
-    for (uint32_t i = 0; i < s->length; i++)
-    {
-        if ( s->text[i] == text[0] ) {
-            uint32_t j = 1;
-            for (; j < textLen; j++)
-            {
-                if (s->text[i + j] != text[j]) {
-                    i += j;
-                    j = INVALID;
-                    break;
-                }
-            }
-            if (j != INVALID) { 
-                contains = true;
-                break;
-            };
-        }
-    }
-    return contains;
+    return _weu_string_search(s->text, s->length, text, (uint32_t)strlen(text), NULL) != WEU_INDEX_INVALID;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SEARCH
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t weu_string_find(const weu_string *s, const char *text, uint32_t from) {
+    if (s == NULL || text == NULL) return WEU_INDEX_INVALID;
+    return _weu_string_searchFrom(s->text, s->length, text, (uint32_t)strlen(text), NULL, from);
+}
+uint32_t weu_string_findText(const char *haystack, uint32_t haystackLen, const char *needle, uint32_t needleLen) {
+    if (haystack == NULL || needle == NULL) return WEU_INDEX_INVALID;
+    return _weu_string_search(haystack, haystackLen, needle, needleLen, NULL);
+}
+weu_list *weu_string_findAll(const weu_string *s, const char *text) {
+    if (s == NULL || text == NULL) return NULL;
+    uint32_t needleLen = (uint32_t)strlen(text);
+    uint32_t table[256];
+    if (needleLen >= WEU_STRING_LONG_NEEDLE) _weu_string_shiftTable((const uint8_t*)text, needleLen, table);
+    return _weu_string_searchAll(s->text, s->length, text, needleLen, needleLen >= WEU_STRING_LONG_NEEDLE ? table : NULL);
+}
+
+weu_stringNeedle *weu_stringNeedle_new(const char *text, uint32_t length) {
+    if (text == NULL && length > 0) return NULL;
+    weu_stringNeedle *out = (weu_stringNeedle*)malloc(sizeof(weu_stringNeedle));
+    out->text   = (char*)malloc(length + 1);
+    out->length = length;
+    if (length > 0) memcpy(out->text, text, length);
+    out->text[length] = '\0';
+    if (length >= WEU_STRING_LONG_NEEDLE) _weu_string_shiftTable((const uint8_t*)out->text, length, out->shift);
+    return out;
+}
+void weu_stringNeedle_free(weu_stringNeedle **handle) {
+    if (*handle == NULL) return;
+    free((*handle)->text);
+    free(*handle);
+    *handle = NULL;
+}
+uint32_t weu_stringNeedle_find(const weu_stringNeedle *needle, const char *haystack, uint32_t haystackLen, uint32_t from) {
+    if (needle == NULL || haystack == NULL) return WEU_INDEX_INVALID;
+    return _weu_string_searchFrom(haystack, haystackLen, needle->text, needle->length, needle->shift, from);
+}
+weu_list *weu_stringNeedle_findAll(const weu_stringNeedle *needle, const char *haystack, uint32_t haystackLen) {
+    if (needle == NULL || haystack == NULL) return NULL;
+    return _weu_string_searchAll(haystack, haystackLen, needle->text, needle->length, needle->shift);
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  STRING CHAR POINTER
@@ -545,12 +1291,8 @@ weu_stringNA weu_stringNA_fill(weu_stringNA s, char fillChar, uint32_t from, uin
 }
 
 weu_string *weu_string_filled(char fillChar, uint32_t len) {
-    weu_string *out = malloc(sizeof(weu_string));
-    out->length = len + 1;
-    out->text = (char*)malloc(len);
+    weu_string *out = weu_string_newSize(len);
     memset(out->text, fillChar, len);
-    out->text[out->length] = '\0';
-    out->charPtrPos = 0;
     return out;
 }
 weu_stringNA weu_stringNA_filled(char fillChar, uint32_t len) {
@@ -571,11 +1313,9 @@ void weu_string_concateString(weu_string *s, uint8_t count, ...) {
     va_start(args, count);
     for (int i = 0; i < count; i++)
     {
-        uint32_t oldLen = s->length;
         weu_string *str = va_arg(args, weu_string*);
         if (str == NULL) continue;
-        weu_string_resize(s, s->length + str->length, ' ');
-        memcpy(s->text + oldLen, str->text, str->length);
+        weu_string_append(s, str->text, str->length);
     }
     va_end(args);
 }
@@ -585,10 +1325,8 @@ void weu_string_concateStringNA(weu_string *s, uint8_t count, ...) {
     va_start(args, count);
     for (int i = 0; i < count; i++)
     {
-        uint32_t oldLen = s->length;
         weu_stringNA str = va_arg(args, weu_stringNA);
-        weu_string_resize(s, s->length + str.length, ' ');
-        memcpy(s->text + oldLen, str.text, str.length);
+        weu_string_append(s, str.text, str.length);
     }
     va_end(args);
 }
@@ -600,13 +1338,48 @@ void weu_string_concateText(weu_string *s, uint8_t count, ...) {
     {
         char *text = va_arg(args, char *);
         if (text == NULL) continue;
-        int textLen = weu_string_textLength(text);
-        int oldLen = s->length;
-        weu_string_resize(s, s->length + textLen, ' ');
-        memcpy(s->text + oldLen, text, textLen);
+        weu_string_append(s, text, weu_string_textLength(text));
     }
     va_end(args);
 }
+void weu_string_append(weu_string *s, const char *text, uint32_t length) {
+    if (s == NULL || text == NULL || length == 0) return;
+    //  Text inside s moves with it when s grows
+    bool inside = text >= s->text && text <= s->text + s->allocLength;
+    size_t offset = inside ? (size_t)(text - s->text) : 0;
+    _weu_string_grow(s, s->length + length);
+    if (inside) text = s->text + offset;
+    memmove(s->text + s->length, text, length);
+    s->length += length;
+    s->text[s->length] = '\0';
+}
+void weu_string_appendChar(weu_string *s, char c) {
+    if (s == NULL) return;
+    _weu_string_grow(s, s->length + 1);
+    s->text[s->length++] = c;
+    s->text[s->length] = '\0';
+}
+//  Room for longest number text is made first, formatter then writes terminator in place.
+void weu_string_appendInt(weu_string *s, int64_t val) {
+    if (s == NULL) return;
+    _weu_string_grow(s, s->length + WEU_CHARCONV_BUFFER);
+    s->length += weu_charconv_formatInt(s->text + s->length, val);
+}
+void weu_string_appendUInt(weu_string *s, uint64_t val) {
+    if (s == NULL) return;
+    _weu_string_grow(s, s->length + WEU_CHARCONV_BUFFER);
+    s->length += weu_charconv_formatUInt(s->text + s->length, val);
+}
+void weu_string_appendFloat(weu_string *s, float val) {
+    if (s == NULL) return;
+    _weu_string_grow(s, s->length + WEU_CHARCONV_BUFFER);
+    s->length += weu_charconv_formatFloat(s->text + s->length, val);
+}
+void weu_string_appendDouble(weu_string *s, double val) {
+    if (s == NULL) return;
+    _weu_string_grow(s, s->length + WEU_CHARCONV_BUFFER);
+    s->length += weu_charconv_formatDouble(s->text + s->length, val);
+}
 
 weu_stringNA weu_stringNA_concatedString(uint8_t count, ...) {
     weu_stringNA out = weu_stringNA_new("");
@@ -729,6 +1502,24 @@ weu_stringNA weu_string_cutLineNA(weu_string *s) {
     weu_string_removeFromTo(s, 0, charPointer + isNewLine);
     return out;
 }
+
+weu_stringLineIterator weu_stringLineIterator_new(const char *text, uint32_t length, bool stripCR) {
+    if (text == NULL) length = 0;
+    return (weu_stringLineIterator){.text = text, .length = length, .pos = 0, .stripCR = stripCR};
+}
+weu_stringLineIterator weu_string_lines(const weu_string *s, bool stripCR) {
+    if (s == NULL) return weu_stringLineIterator_new(NULL, 0, stripCR);
+    return weu_stringLineIterator_new(s->text, s->length, stripCR);
+}
+bool weu_stringLineIterator_next(weu_stringLineIterator *it, weu_string *lineOut) {
+    if (it == NULL || it->pos >= it->length) return false;
+    uint32_t end = _weu_string_findChar(it->text, it->length, '\n', it->pos);
+    uint32_t lineEnd = end;
+    if (it->stripCR && lineEnd > it->pos && it->text[lineEnd - 1] == '\r') --lineEnd;
+    if (lineOut != NULL) *lineOut = (weu_string){.allocLength = 0, .charPtrPos = it->pos, .length = lineEnd - it->pos, .text = (char*)it->text + it->pos};
+    it->pos = end < it->length ? end + 1 : it->length;
+    return true;
+}
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  SPLIT
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -736,42 +1527,63 @@ weu_stringNA weu_string_cutLineNA(weu_string *s) {
 weu_list *weu_string_splitByChar(const weu_string *s, char c) {
     if (s == NULL) return NULL;
     weu_list *out = weu_list_new(8, sizeof(weu_string*), weu_string_datafreefun);
-    uint32_t sbeg = 0;
-    for (uint32_t i = 0; i < s->length; i++) {
-        if (s->text[i] == c) {
-            weu_list_push(out, weu_string_fromTo(s, sbeg, i));
-            sbeg = i + 1;
-        }
-    }
-    if (sbeg < s->length) {
-        weu_list_push(out, weu_string_fromTo(s, sbeg, s->length));
+    weu_stringTokenizer t = weu_stringTokenizer_new(s->text, s->length, c);
+    weu_string token;
+    while (weu_stringTokenizer_next(&t, &token)) {
+        weu_string *piece = weu_string_fromTo(&token, 0, token.length);
+        weu_list_push(out, &piece);
     }
     return out;
 }
 weu_list *weu_string_splitByText(const weu_string *s, const char *text) {
     if (s == NULL || text == NULL) return NULL;
     weu_list *out = weu_list_new(8, sizeof(weu_string*), weu_string_datafreefun);
-    uint32_t textLen = strlen(text);
-    uint32_t sbeg = 0;
-    for (uint32_t i = 0; i < s->length; i++) {
-        uint32_t match = 0;
-        for (uint32_t j = 0; j < textLen; j++) {
-            if (s->text[i + j] == text[j]) ++match;
-            else {
-                i += j;
-                break;
-            }
-        }
-        if (match == textLen) {
-            weu_list_push(out, weu_string_fromTo(s, sbeg, i));
-            i += textLen;
-            sbeg = i;
-        }
-        match = 0;
+    weu_stringTokenizer t = weu_stringTokenizer_newText(s->text, s->length, text, (uint32_t)strlen(text));
+    weu_string token;
+    while (weu_stringTokenizer_next(&t, &token)) {
+        weu_string *piece = weu_string_fromTo(&token, 0, token.length);
+        weu_list_push(out, &piece);
     }
-    if (sbeg < s->length) weu_list_push(out, weu_string_fromTo(s, sbeg, s->length));
     return out;
 }
+
+weu_stringTokenizer weu_stringTokenizer_new(const char *text, uint32_t length, char delimiter) {
+    if (text == NULL) length = 0;
+    return (weu_stringTokenizer){.text = text, .length = length, .pos = 0, .delimiterText = NULL, .delimiterLength = 0, .delimiter = delimiter};
+}
+weu_stringTokenizer weu_stringTokenizer_newText(const char *text, uint32_t length, const char *delimiter, uint32_t delimiterLength) {
+    if (text == NULL) length = 0;
+    if (delimiter == NULL) delimiterLength = 0;
+    if (delimiterLength == 1) return weu_stringTokenizer_new(text, length, delimiter[0]);
+    //  Empty delimiter never matches, whole text is single token
+    return (weu_stringTokenizer){.text = text, .length = length, .pos = 0, .delimiterText = delimiterLength > 0 ? delimiter : "", .delimiterLength = delimiterLength, .delimiter = 0};
+}
+bool weu_stringTokenizer_next(weu_stringTokenizer *t, weu_string *tokenOut) {
+    if (t == NULL || t->pos >= t->length) return false;
+    uint32_t end, next;
+    if (t->delimiterText == NULL) {
+        end = _weu_string_findChar(t->text, t->length, t->delimiter, t->pos);
+        next = end + 1;
+    } else {
+        end = t->delimiterLength > 0 ? _weu_string_searchFrom(t->text, t->length, t->delimiterText, t->delimiterLength, NULL, t->pos) : WEU_INDEX_INVALID;
+        if (end == WEU_INDEX_INVALID) end = t->length;
+        next = end + t->delimiterLength;
+    }
+    if (tokenOut != NULL) *tokenOut = (weu_string){.allocLength = 0, .charPtrPos = t->pos, .length = end - t->pos, .text = (char*)t->text + t->pos};
+    t->pos = end < t->length ? next : t->length;
+    return true;
+}
+
+uint32_t weu_string_splitViews(const weu_string *s, char delimiter, weu_string *out, uint32_t maxCount) {
+    if (s == NULL || out == NULL || maxCount == 0) return 0;
+    weu_stringTokenizer t = weu_stringTokenizer_new(s->text, s->length, delimiter);
+    uint32_t count = 0;
+    while (count + 1 < maxCount && weu_stringTokenizer_next(&t, &out[count])) ++count;
+    if (t.pos < t.length) {
+        out[count++] = (weu_string){.allocLength = 0, .charPtrPos = t.pos, .length = t.length - t.pos, .text = s->text + t.pos};
+    }
+    return count;
+}
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  CHAR REPLACE
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -906,12 +1718,10 @@ weu_stringNA weu_stringNA_removeCharsFromEnd(weu_stringNA s, char charToRemove)
 void weu_string_addIndent(weu_string *s, uint8_t count, uint8_t spaceCount) {
     if (s == NULL) return;
     uint32_t tabLen = count * spaceCount;
-    uint32_t finalLength = s->length + tabLen;
-    if (finalLength > s->allocLength) {
-        weu_string_resize(s, finalLength, ' ');
-    }
-    memmove(&s->text[tabLen], &s->text[0], s->length);
-    memset(&s->text[0], ' ', tabLen);   
+    uint32_t oldLength = s->length;
+    weu_string_resize(s, oldLength + tabLen, ' ');
+    memmove(&s->text[tabLen], &s->text[0], oldLength);
+    memset(&s->text[0], ' ', tabLen);
 }
 weu_string *weu_string_addedIndent(const weu_string *s, uint8_t count, uint8_t spaceCount) {
     if (s == NULL) return NULL;
@@ -971,6 +1781,12 @@ weu_stringNA weu_stringNA_removeIndent(const weu_stringNA s) {
 //  EXPRESSION
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//  List holds weu_string pointers like lists of split functions.
+static void _weu_string_pushVarying(weu_list *list, const char *text, uint32_t length) {
+    weu_string *piece = weu_string_newSize(length);
+    memcpy(piece->text, text, length);
+    weu_list_push(list, &piece);
+}
 bool weu_string_textMatchesExpression(const char *text, const char *expression, weu_list *varyingStringOut, weu_bitfield_32 *isMatching) {
     if (text == NULL || expression == NULL) return false;
 
@@ -1012,7 +1828,7 @@ bool weu_string_textMatchesExpression(const char *text, const char *expression,
             if      (expression[expPos] == 'c') charTest = true;
             else if (expression[expPos] == 's') charTest = false;
             else {
-                if (varyingStringOut) weu_list_push(varyingStringOut, weu_string_newChar(text[txtPos])); 
+                if (varyingStringOut) _weu_string_pushVarying(varyingStringOut, &text[txtPos], 1);
                 match = false;
                 break; 
             }
@@ -1046,13 +1862,13 @@ bool weu_string_textMatchesExpression(const char *text, const char *expression,
             {
                 if (txtPos >= textLen) {
                     match = false;
-                    weu_list_push(varyingStringOut, weu_string_new(""));
+                    if (varyingStringOut) _weu_string_pushVarying(varyingStringOut, "", 0);
                     ++varyCount;
                     continue;
                 }
 
                 if (charTest) {
-                    if (varyingStringOut) weu_list_push(varyingStringOut, weu_string_newChar(text[txtPos]));
+                    if (varyingStringOut) _weu_string_pushVarying(varyingStringOut, &text[txtPos], 1);
                     if (!weu_string_charMatchesCondition(text[txtPos], condition.text)) {
                         match = false;
                     }
@@ -1077,7 +1893,7 @@ bool weu_string_textMatchesExpression(const char *text, const char *expression,
                     //  Skip over string end char
                     if (hitEndCh) ++expPos;
                     
-                    if (varyingStringOut) weu_list_push(varyingStringOut, weu_string_new(str.text));
+                    if (varyingStringOut) _weu_string_pushVarying(varyingStringOut, str.text, str.length);
                     if (!weu_string_textMatchesCondition(str.text, condition.text)) {
                         match = false;
                     }
@@ -1161,84 +1977,536 @@ bool weu_string_charMatchesCondition(const uint8_t c, const char *condition) {
 bool weu_string_textMatchesCondition(const char *text, const char *condition) {
     if (text == NULL || condition == NULL) return false;
     uint32_t textLen = strlen(text);
+    //  Compiling class costs about as much as testing few dozen characters one by one
+    if (textLen >= 64) {
+        weu_charClass c = weu_charClass_new(condition);
+        return weu_charClass_all(&c, text, textLen);
+    }
     for (uint32_t i = 0; i < textLen; i++)
     {
         if (!weu_string_charMatchesCondition(text[i], condition)) { return false; }
     }
     return true;
 }
+
+static inline bool _weu_charClass_contains(const weu_charClass *c, uint8_t ch) {
+    return (c->bits[ch >> 6] >> (ch & 63)) & 1;
+}
+//  Fills SIMD tables from bits.
+static void _weu_charClass_setNibbles(weu_charClass *c) {
+    memset(c->nibbles, 0, sizeof(c->nibbles));
+    for (uint32_t ch = 0; ch < 256; ch++) {
+        if (_weu_charClass_contains(c, (uint8_t)ch)) c->nibbles[(ch >> 7) * 16 + (ch & 15)] |= (uint8_t)(1 << ((ch >> 4) & 7));
+    }
+}
+#if defined(WEU_STRING_AVX2)
+//  0xff for bytes in class: low nibble selects row of bits, high nibble selects bit of row.
+//  Rows of bytes below and above 0x80 are looked up separately, pshufb zeroes lanes with top bit set.
+static inline __m256i _weu_charClass_classify32(__m256i x, __m256i rowsLow, __m256i rowsHigh, __m256i bits) {
+    __m256i indexLow    = _mm256_and_si256(x, _mm256_set1_epi8((char)0x8f));
+    __m256i indexHigh   = _mm256_xor_si256(indexLow, _mm256_set1_epi8((char)0x80));
+    __m256i row         = _mm256_or_si256(_mm256_shuffle_epi8(rowsLow, indexLow), _mm256_shuffle_epi8(rowsHigh, indexHigh));
+    __m256i bit         = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(x, 4), _mm256_set1_epi8(0x0f)));
+    return _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+}
+#endif
+#if defined(WEU_STRING_SSSE3)
+static inline __m128i _weu_charClass_classify16(__m128i x, __m128i rowsLow, __m128i rowsHigh, __m128i bits) {
+    __m128i indexLow    = _mm_and_si128(x, _mm_set1_epi8((char)0x8f));
+    __m128i indexHigh   = _mm_xor_si128(indexLow, _mm_set1_epi8((char)0x80));
+    __m128i row         = _mm_or_si128(_mm_shuffle_epi8(rowsLow, indexLow), _mm_shuffle_epi8(rowsHigh, indexHigh));
+    __m128i bit         = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0f)));
+    return _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+}
+#endif
+static const uint8_t _weu_charClass_bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+
+//  Returns position of first byte at or after from that is in class when inClass is true,
+//  or is not in class when it is false, length if there is none.
+static uint32_t _weu_charClass_scan(const weu_charClass *c, const char *text, uint32_t length, uint32_t from, bool inClass) {
+    uint32_t i = from;
+#if defined(WEU_STRING_AVX2)
+    const __m256i rowsLow32  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)c->nibbles));
+    const __m256i rowsHigh32 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(c->nibbles + 16)));
+    const __m256i bits32     = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)_weu_charClass_bits));
+    const uint32_t flip32    = inClass ? 0 : 0xffffffffu;
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(text + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_weu_charClass_classify32(x, rowsLow32, rowsHigh32, bits32)) ^ flip32;
+        if (mask != 0) return i + _weu_string_ctz(mask);
+    }
+#endif
+#if defined(WEU_STRING_SSSE3)
+    const __m128i rowsLow16  = _mm_loadu_si128((const __m128i*)c->nibbles);
+    const __m128i rowsHigh16 = _mm_loadu_si128((const __m128i*)(c->nibbles + 16));
+    const __m128i bits16     = _mm_loadu_si128((const __m128i*)_weu_charClass_bits);
+    const uint32_t flip16    = inClass ? 0 : 0xffffu;
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(text + i));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_weu_charClass_classify16(x, rowsLow16, rowsHigh16, bits16)) ^ flip16;
+        if (mask != 0) return i + _weu_string_ctz(mask);
+    }
+#endif
+    for (; i < length; i++) {
+        if (_weu_charClass_contains(c, (uint8_t)text[i]) == inClass) return i;
+    }
+    return length;
+}
+weu_charClass weu_charClass_new(const char *condition) {
+    //  Condition only compares tested character with its own characters, so result is same
+    //  for all bytes between two of them. It is evaluated once per such run, class then
+    //  accepts exactly what weu_string_charMatchesCondition accepts.
+    weu_charClass out = {{0}, {0}};
+    if (condition == NULL) return out;
+    //  Terminator counts as well, parser looks past it at ends of some conditions
+    weu_charClass boundaries = {{1}, {0}};
+    for (const char *p = condition; *p != '\0'; p++) boundaries.bits[(uint8_t)*p >> 6] |= 1ull << ((uint8_t)*p & 63);
+    bool accepted = false;
+    for (uint32_t ch = 0; ch < 256; ch++) {
+        if (_weu_charClass_contains(&boundaries, (uint8_t)ch) || _weu_charClass_contains(&boundaries, (uint8_t)(ch - 1))) {
+            accepted = weu_string_charMatchesCondition((uint8_t)ch, condition);
+        }
+        if (accepted) out.bits[ch >> 6] |= 1ull << (ch & 63);
+    }
+    _weu_charClass_setNibbles(&out);
+    return out;
+}
+weu_charClass weu_charClass_fromChars(const char *chars, uint32_t length) {
+    weu_charClass out = {{0}, {0}};
+    for (uint32_t i = 0; chars != NULL && i < length; i++) out.bits[(uint8_t)chars[i] >> 6] |= 1ull << ((uint8_t)chars[i] & 63);
+    _weu_charClass_setNibbles(&out);
+    return out;
+}
+bool weu_charClass_contains(const weu_charClass *c, uint8_t ch) {
+    if (c == NULL) return false;
+    return _weu_charClass_contains(c, ch);
+}
+bool weu_charClass_all(const weu_charClass *c, const char *text, uint32_t length) {
+    if (c == NULL || (text == NULL && length > 0)) return false;
+    return _weu_charClass_scan(c, text, length, 0, false) == length;
+}
+uint32_t weu_charClass_find(const weu_charClass *c, const char *text, uint32_t length, uint32_t from) {
+    if (c == NULL || text == NULL || from >= length) return WEU_INDEX_INVALID;
+    uint32_t pos = _weu_charClass_scan(c, text, length, from, true);
+    return pos < length ? pos : WEU_INDEX_INVALID;
+}
+uint32_t weu_charClass_findNot(const weu_charClass *c, const char *text, uint32_t length, uint32_t from) {
+    if (c == NULL || text == NULL || from >= length) return WEU_INDEX_INVALID;
+    uint32_t pos = _weu_charClass_scan(c, text, length, from, false);
+    return pos < length ? pos : WEU_INDEX_INVALID;
+}
+uint32_t weu_charClass_count(const weu_charClass *c, const char *text, uint32_t length) {
+    if (c == NULL || text == NULL) return 0;
+    uint32_t out = 0, i = 0;
+#if defined(WEU_STRING_AVX2)
+    const __m256i rowsLow32  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)c->nibbles));
+    const __m256i rowsHigh32 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(c->nibbles + 16)));
+    const __m256i bits32     = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)_weu_charClass_bits));
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(text + i));
+        out += _weu_string_popcount((uint32_t)_mm256_movemask_epi8(_weu_charClass_classify32(x, rowsLow32, rowsHigh32, bits32)));
+    }
+#endif
+#if defined(WEU_STRING_SSSE3)
+    const __m128i rowsLow16  = _mm_loadu_si128((const __m128i*)c->nibbles);
+    const __m128i rowsHigh16 = _mm_loadu_si128((const __m128i*)(c->nibbles + 16));
+    const __m128i bits16     = _mm_loadu_si128((const __m128i*)_weu_charClass_bits);
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(text + i));
+        out += _weu_string_popcount((uint32_t)_mm_movemask_epi8(_weu_charClass_classify16(x, rowsLow16, rowsHigh16, bits16)));
+    }
+#endif
+    for (; i < length; i++) out += _weu_charClass_contains(c, (uint8_t)text[i]);
+    return out;
+}
+
+weu_expression *weu_expression_compile(const char *expression) {
+    if (expression == NULL) return NULL;
+    uint32_t exprLen = weu_string_textLength(expression);
+    weu_expression *out = (weu_expression*)calloc(1, sizeof(weu_expression));
+    out->literals   = (char*)malloc((size_t)exprLen + 1);
+    out->parts      = (weu_expressionPart*)malloc(sizeof(weu_expressionPart) * ((size_t)exprLen + 1));
+    uint32_t literalLength = 0;
+    for (uint32_t expPos = 0; expPos < exprLen;) {
+        if (expression[expPos] != '%') {
+            weu_expressionPart *last = out->partCount > 0 ? &out->parts[out->partCount - 1] : NULL;
+            if (last == NULL || last->kind != WEU_EXPRESSION_LITERAL) {
+                last = &out->parts[out->partCount++];
+                *last = (weu_expressionPart){.kind = WEU_EXPRESSION_LITERAL, .offset = literalLength};
+            }
+            out->literals[literalLength++] = expression[expPos++];
+            ++last->length;
+            continue;
+        }
+        ++expPos;
+        weu_expressionPart part = {.count = 1};
+        //  READ COUNT
+        if (expression[expPos] >= '0' && expression[expPos] <= '9') {
+            if (expression[expPos] > '1') part.count = (uint8_t)(expression[expPos] - '0');
+            ++expPos;
+        }
+        //  TEST CONTEXT
+        if      (expression[expPos] == 'c') part.kind = WEU_EXPRESSION_CHAR;
+        else if (expression[expPos] == 's') part.kind = WEU_EXPRESSION_STRING;
+        else {
+            weu_expression_free(&out);
+            return NULL;
+        }
+        ++expPos;
+        //  STRING READ END CONDITION, terminator always ends string
+        char ends[6] = {0};
+        uint32_t endCount = 1;
+        if (expression[expPos] == '{') {
+            ++expPos;
+            for (; expression[expPos] != '}' && expression[expPos] != '\0'; expPos++) {
+                if (endCount < 6) ends[endCount++] = expression[expPos];
+            }
+            if (expression[expPos] == '}') ++expPos;
+        }
+        part.ends = weu_charClass_fromChars(ends, endCount);
+        //  CONDITION
+        if (expression[expPos] == '[') {
+            uint32_t startPos = expPos++;
+            while (expression[expPos] != ']' && expression[expPos] != '\0') ++expPos;
+            if (expression[expPos] == ']') ++expPos;
+            weu_stringNA condition = weu_stringNA_textFromTo(expression, startPos, expPos);
+            part.condition = weu_charClass_new(condition.text);
+        } else {
+            part.condition = weu_charClass_new("");
+        }
+        out->varyingCount += part.count;
+        out->parts[out->partCount++] = part;
+    }
+    out->literals[literalLength] = '\0';
+    return out;
+}
+void weu_expression_free(weu_expression **handle) {
+    weu_expression *e = *handle;
+    if (e == NULL) return;
+    free(e->parts);
+    free(e->literals);
+    free(e);
+    *handle = NULL;
+}
+bool weu_expression_match(const weu_expression *e, const char *text, uint32_t length, weu_string *varyingOut, weu_bitfield_32 *isMatching) {
+    if (e == NULL || (text == NULL && length > 0)) return false;
+    if (text == NULL) text = "";
+    uint32_t txtPos     = 0;
+    uint32_t varyCount  = 0;
+    uint32_t skip       = 0;
+    weu_bitfield_32 bf  = 0;
+    bool match          = true;
+    bool complete       = true;
+    for (uint32_t p = 0; p < e->partCount && complete; p++) {
+        const weu_expressionPart *part = &e->parts[p];
+        if (part->kind == WEU_EXPRESSION_LITERAL) {
+            uint32_t n = part->length - skip;
+            //  Text ending inside literal fails whole match
+            if (length - txtPos < n) { complete = false; break; }
+            if (memcmp(text + txtPos, e->literals + part->offset + skip, n) != 0) match = false;
+            txtPos += n;
+            skip = 0;
+            continue;
+        }
+        int endChar = -1;
+        for (uint32_t i = 0; i < part->count; i++, varyCount++) {
+            weu_string view = {.text = (char*)text + txtPos};
+            bool valid = false;
+            if (txtPos < length && part->kind == WEU_EXPRESSION_CHAR) {
+                view.length = 1;
+                valid = _weu_charClass_contains(&part->condition, (uint8_t)text[txtPos++]);
+            } else if (txtPos < length) {
+                //  First character always belongs to string
+                uint32_t startPos = txtPos;
+                txtPos = _weu_charClass_scan(&part->ends, text, length, startPos + 1, true);
+                view.length = txtPos - startPos;
+                valid = _weu_charClass_scan(&part->condition, text, txtPos, startPos, false) == txtPos;
+                endChar = txtPos < length ? (uint8_t)text[txtPos++] : -1;
+            }
+            if (varyingOut) varyingOut[varyCount] = view;
+            if (!valid) match = false;
+            else if (varyCount < 32) SET_BIT32(bf, varyCount);
+        }
+        if (endChar >= 0 && p + 1 < e->partCount && e->parts[p + 1].kind == WEU_EXPRESSION_LITERAL &&
+            (uint8_t)e->literals[e->parts[p + 1].offset] == endChar) skip = 1;
+    }
+    if (varyingOut) {
+        for (; varyCount < e->varyingCount; varyCount++) varyingOut[varyCount] = (weu_string){.text = (char*)text + length};
+    }
+    if (isMatching) *isMatching = bf;
+    return complete && txtPos == length && match;
+}
+weu_expressionSet *weu_expressionSet_new(const char **expressions, uint32_t count) {
+    if (expressions == NULL && count > 0) return NULL;
+    weu_expressionSet *out  = (weu_expressionSet*)calloc(1, sizeof(weu_expressionSet));
+    out->patterns           = (weu_expression**)calloc((size_t)count + 1, sizeof(weu_expression*));
+    out->captureOffsets     = (uint32_t*)malloc(sizeof(uint32_t) * ((size_t)count + 1));
+    out->patternCount       = count;
+    //  Literals never hold terminator or %, so classes fit byte
+    out->classCount         = 1;
+    uint32_t literalBytes   = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        out->patterns[i] = weu_expression_compile(expressions[i]);
+        if (out->patterns[i] == NULL) {
+            weu_expressionSet_free(&out);
+            return NULL;
+        }
+        out->captureOffsets[i] = out->captureCount;
+        out->captureCount += out->patterns[i]->varyingCount;
+        for (uint32_t p = 0; p < out->patterns[i]->partCount; p++) {
+            const weu_expressionPart *part = &out->patterns[i]->parts[p];
+            if (part->kind != WEU_EXPRESSION_LITERAL) continue;
+            literalBytes += part->length;
+            for (uint32_t j = 0; j < part->length; j++) {
+                uint8_t ch = (uint8_t)out->patterns[i]->literals[part->offset + j];
+                if (out->byteClasses[ch] == 0) out->byteClasses[ch] = (uint8_t)out->classCount++;
+            }
+        }
+    }
+    //  TRIE OF DISTINCT LITERALS
+    const uint32_t classCount = out->classCount;
+    uint32_t maxStates  = literalBytes + 1;
+    uint32_t *next      = (uint32_t*)malloc(sizeof(uint32_t) * maxStates * classCount);
+    uint32_t *keywords  = (uint32_t*)malloc(sizeof(uint32_t) * maxStates);
+    uint32_t *pairs     = (uint32_t*)malloc(sizeof(uint32_t) * 2 * maxStates);
+    uint32_t *lastIds   = (uint32_t*)malloc(sizeof(uint32_t) * maxStates);
+    for (uint32_t i = 0; i < maxStates * classCount; i++) next[i] = WEU_INDEX_INVALID;
+    for (uint32_t i = 0; i < maxStates; i++) keywords[i] = WEU_INDEX_INVALID;
+    out->required       = (uint32_t*)calloc((size_t)count + 1, sizeof(uint32_t));
+    out->unfiltered     = (uint32_t*)malloc(sizeof(uint32_t) * ((size_t)count + 1));
+    out->stateCount     = 1;
+    uint32_t pairCount  = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const weu_expression *e = out->patterns[i];
+        for (uint32_t p = 0; p < e->partCount; p++) {
+            if (e->parts[p].kind != WEU_EXPRESSION_LITERAL) continue;
+            uint32_t state = 0;
+            for (uint32_t j = 0; j < e->parts[p].length; j++) {
+                uint32_t *t = &next[state * classCount + out->byteClasses[(uint8_t)e->literals[e->parts[p].offset + j]]];
+                if (*t == WEU_INDEX_INVALID) *t = out->stateCount++;
+                state = *t;
+            }
+            if (keywords[state] == WEU_INDEX_INVALID) {
+                keywords[state] = out->keywordCount;
+                lastIds[out->keywordCount++] = WEU_INDEX_INVALID;
+            }
+            //  Repeated literal of pattern is required once
+            uint32_t k = keywords[state];
+            if (lastIds[k] == i) continue;
+            lastIds[k] = i;
+            pairs[pairCount * 2]        = k;
+            pairs[pairCount * 2 + 1]    = i;
+            ++pairCount;
+            ++out->required[i];
+        }
+        if (out->required[i] == 0) out->unfiltered[out->unfilteredCount++] = i;
+    }
+    //  PATTERNS OF LITERALS, ids stay ascending per literal
+    out->referenceStarts    = (uint32_t*)calloc((size_t)out->keywordCount + 1, sizeof(uint32_t));
+    out->references         = (uint32_t*)malloc(sizeof(uint32_t) * ((size_t)pairCount + 1));
+    for (uint32_t i = 0; i < pairCount; i++) ++out->referenceStarts[pairs[i * 2] + 1];
+    for (uint32_t k = 0; k < out->keywordCount; k++) {
+        out->referenceStarts[k + 1] += out->referenceStarts[k];
+        lastIds[k] = out->referenceStarts[k];
+    }
+    for (uint32_t i = 0; i < pairCount; i++) out->references[lastIds[pairs[i * 2]]++] = pairs[i * 2 + 1];
+    //  FAILURE LINKS, breadth first so missing transitions copy complete row of shallower failure state
+    uint32_t *fail  = (uint32_t*)malloc(sizeof(uint32_t) * out->stateCount);
+    uint32_t *queue = (uint32_t*)malloc(sizeof(uint32_t) * out->stateCount);
+    out->outputs    = (uint32_t*)calloc(out->stateCount, sizeof(uint32_t));
+    uint32_t head = 0, tail = 0;
+    for (uint32_t a = 0; a < classCount; a++) {
+        if (next[a] == WEU_INDEX_INVALID) next[a] = 0;
+        else {
+            fail[next[a]] = 0;
+            queue[tail++] = next[a];
+        }
+    }
+    while (head < tail) {
+        uint32_t state = queue[head++];
+        for (uint32_t a = 0; a < classCount; a++) {
+            uint32_t t = next[state * classCount + a];
+            uint32_t f = next[fail[state] * classCount + a];
+            if (t == WEU_INDEX_INVALID) {
+                next[state * classCount + a] = f;
+                continue;
+            }
+            fail[t]         = f;
+            out->outputs[t] = keywords[f] != WEU_INDEX_INVALID ? f : out->outputs[f];
+            queue[tail++]   = t;
+        }
+    }
+    out->transitions    = (uint32_t*)realloc(next, sizeof(uint32_t) * out->stateCount * classCount);
+    out->keywords       = (uint32_t*)realloc(keywords, sizeof(uint32_t) * out->stateCount);
+    out->keywordStamps  = (uint32_t*)calloc((size_t)out->keywordCount + 1, sizeof(uint32_t));
+    out->patternStamps  = (uint32_t*)calloc((size_t)count + 1, sizeof(uint32_t));
+    out->found          = (uint32_t*)calloc((size_t)count + 1, sizeof(uint32_t));
+    out->candidates     = (uint32_t*)malloc(sizeof(uint32_t) * ((size_t)count + 1));
+    free(pairs);
+    free(lastIds);
+    free(fail);
+    free(queue);
+    return out;
+}
+void weu_expressionSet_free(weu_expressionSet **handle) {
+    weu_expressionSet *set = *handle;
+    if (set == NULL) return;
+    for (uint32_t i = 0; set->patterns != NULL && i < set->patternCount; i++) weu_expression_free(&set->patterns[i]);
+    free(set->patterns);
+    free(set->captureOffsets);
+    free(set->transitions);
+    free(set->keywords);
+    free(set->outputs);
+    free(set->referenceStarts);
+    free(set->references);
+    free(set->required);
+    free(set->unfiltered);
+    free(set->keywordStamps);
+    free(set->patternStamps);
+    free(set->found);
+    free(set->candidates);
+    free(set);
+    *handle = NULL;
+}
+uint32_t weu_expressionSet_match(weu_expressionSet *set, const char *text, uint32_t length, uint32_t *idsOut, weu_string *capturesOut) {
+    if (set == NULL || (text == NULL && length > 0)) return 0;
+    if (text == NULL) text = "";
+    if (++set->pass == 0) {
+        memset(set->keywordStamps, 0, sizeof(uint32_t) * set->keywordCount);
+        memset(set->patternStamps, 0, sizeof(uint32_t) * set->patternCount);
+        set->pass = 1;
+    }
+    const uint32_t pass         = set->pass;
+    const uint32_t classCount   = set->classCount;
+    uint32_t candidateCount     = 0;
+    uint32_t state              = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        state = set->transitions[state * classCount + set->byteClasses[(uint8_t)text[i]]];
+        //  Whole suffix chain was reported with first literal of it seen before
+        for (uint32_t o = set->keywords[state] != WEU_INDEX_INVALID ? state : set->outputs[state]; o != 0; o = set->outputs[o]) {
+            uint32_t k = set->keywords[o];
+            if (set->keywordStamps[k] == pass) break;
+            set->keywordStamps[k] = pass;
+            for (uint32_t r = set->referenceStarts[k]; r < set->referenceStarts[k + 1]; r++) {
+                uint32_t id = set->references[r];
+                if (set->patternStamps[id] != pass) {
+                    set->patternStamps[id]  = pass;
+                    set->found[id]          = 0;
+                }
+                if (++set->found[id] == set->required[id]) set->candidates[candidateCount++] = id;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < set->unfilteredCount; i++) set->candidates[candidateCount++] = set->unfiltered[i];
+    //  Candidates are few, insertion sort keeps ids ascending
+    for (uint32_t i = 1; i < candidateCount; i++) {
+        uint32_t id = set->candidates[i], j = i;
+        for (; j > 0 && set->candidates[j - 1] > id; j--) set->candidates[j] = set->candidates[j - 1];
+        set->candidates[j] = id;
+    }
+    uint32_t matchCount = 0;
+    for (uint32_t i = 0; i < candidateCount; i++) {
+        uint32_t id = set->candidates[i];
+        if (!weu_expression_match(set->patterns[id], text, length, capturesOut ? capturesOut + set->captureOffsets[id] : NULL, NULL)) continue;
+        if (idsOut) idsOut[matchCount] = id;
+        ++matchCount;
+    }
+    return matchCount;
+}
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PARSE
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//  Skips white space and plus sign like atoi, returns length of text left.
+static uint32_t _weu_string_numberStart(const char **text) {
+    const char *p = *text != NULL ? *text : "";
+    while (*p == ' ' || (*p >= '\t' && *p <= '\r')) ++p;
+    if (*p == '+' && *(p + 1) != '-') ++p;
+    *text = p;
+    return weu_string_textLength(p);
+}
 int weu_string_parseInt(const char *text) {
-    return atoi(text);
+    int64_t out = 0;
+    uint32_t length = _weu_string_numberStart(&text);
+    if (weu_charconv_parseInt(text, length, &out, NULL) == WEU_CHARCONV_OUT_OF_RANGE) out = text[0] == '-' ? INT32_MIN : INT32_MAX;
+    return out < INT32_MIN ? INT32_MIN : out > INT32_MAX ? INT32_MAX : (int)out;
 }
 float weu_string_parseFloat(const char *text) {
-    return atof(text);
+    float out = 0;
+    uint32_t length = _weu_string_numberStart(&text);
+    weu_charconv_parseFloat(text, length, &out, NULL);
+    return out;
 }
 long long weu_string_parseLLong(const char *text) {
-    return atoll(text);
+    int64_t out = 0;
+    uint32_t length = _weu_string_numberStart(&text);
+    if (weu_charconv_parseInt(text, length, &out, NULL) == WEU_CHARCONV_OUT_OF_RANGE) out = text[0] == '-' ? INT64_MIN : INT64_MAX;
+    return out;
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  TO STRING
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
-weu_string *weu_string_float(float val) {
-    char buffer[64];
-    sprintf(buffer, "%f", val);
-    weu_string *out = weu_string_new(buffer);
+//  Number text is formatted on stack and copied once into string of exact size.
+static weu_string *_weu_string_number(const char *buffer, uint32_t length) {
+    weu_string *out = weu_string_newSize(length);
+    memcpy(out->text, buffer, length);
     return out;
 }
+weu_string *weu_string_float(float val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    return _weu_string_number(buffer, weu_charconv_formatFloat(buffer, val));
+}
+weu_string *weu_string_double(double val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    return _weu_string_number(buffer, weu_charconv_formatDouble(buffer, val));
+}
 weu_string *weu_string_int(int32_t val) {
-    char buffer[64];
-    sprintf(buffer, "%i", val);
-    weu_string *out = weu_string_new(buffer);
-    return out;
+    char buffer[WEU_CHARCONV_BUFFER];
+    return _weu_string_number(buffer, weu_charconv_formatInt(buffer, val));
 }
 weu_string *weu_string_uint(uint32_t val) {
-    char buffer[64];
-    sprintf(buffer, "%u", val);
-    weu_string *out = weu_string_new(buffer);
-    return out;
+    char buffer[WEU_CHARCONV_BUFFER];
+    return _weu_string_number(buffer, weu_charconv_formatUInt(buffer, val));
 }
 weu_string *weu_string_llong(int64_t val) {
-    char buffer[64];
-    sprintf(buffer, "%ld", val);
-    weu_string *out = weu_string_new(buffer);
-    return out;
+    char buffer[WEU_CHARCONV_BUFFER];
+    return _weu_string_number(buffer, weu_charconv_formatInt(buffer, val));
 }
 weu_string *weu_string_ullong(uint64_t val) {
-    char buffer[64];
-    sprintf(buffer, "%lu", val);
-    weu_string *out = weu_string_new(buffer);
-    return out;
+    char buffer[WEU_CHARCONV_BUFFER];
+    return _weu_string_number(buffer, weu_charconv_formatUInt(buffer, val));
 }
 
 weu_stringNA weu_string_floatNA(float val) {
-    char buffer[64];
-    sprintf(buffer, "%f", val);
-    return weu_stringNA_new(buffer);
+    weu_stringNA out;
+    out.length = weu_charconv_formatFloat(out.text, val);
+    return out;
+}
+weu_stringNA weu_string_doubleNA(double val) {
+    weu_stringNA out;
+    out.length = weu_charconv_formatDouble(out.text, val);
+    return out;
 }
 weu_stringNA weu_string_intNA(int32_t val) {
-    char buffer[64];
-    sprintf(buffer, "%i", val);
-    return weu_stringNA_new(buffer);
+    weu_stringNA out;
+    out.length = weu_charconv_formatInt(out.text, val);
+    return out;
 }
 weu_stringNA weu_string_uintNA(uint32_t val) {
-    char buffer[64];
-    sprintf(buffer, "%u", val);
-    return weu_stringNA_new(buffer);
+    weu_stringNA out;
+    out.length = weu_charconv_formatUInt(out.text, val);
+    return out;
 }
 weu_stringNA weu_string_llongNA(int64_t val) {
-    char buffer[64];
-    sprintf(buffer, "%ld", val);
-    return weu_stringNA_new(buffer);
+    weu_stringNA out;
+    out.length = weu_charconv_formatInt(out.text, val);
+    return out;
 }
 weu_stringNA weu_string_ullongNA(uint64_t val) {
-    char buffer[64];
-    sprintf(buffer, "%lu", val);
-    return weu_stringNA_new(buffer);
+    weu_stringNA out;
+    out.length = weu_charconv_formatUInt(out.text, val);
+    return out;
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 //  DEBUG
@@ -0,0 +1,203 @@
+/*///////////////////////////////////////////////////////////////////////////////////
+//  SPDX-License-Identifier: Unlicense
+/////////////////////////////////////////////////////////////////////////////////////
+//  USAGE
+//  Functions are defined as extern.
+//  To implement somewhere in source file before including header file
+//  #define WEU_IMPLEMENTATION
+//  Implementation should be defined once.
+//
+//  #define WEU_IMPLEMENTATION
+//  #include <path_to_lib/weu_master.h>
+//
+//  To include all weu library in souce file at once, include weu_master.h
+*////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef weu_stringbuilder_h
+#define weu_stringbuilder_h
+
+#define WEUDEF extern
+
+#include "weu_datatypes.h"
+#include "weu_string.h"
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#ifndef WEU_STRINGBUILDER_CHUNK
+#define WEU_STRINGBUILDER_CHUNK 65536
+#endif
+
+//  Appended text is copied once into chunks, chunks are never reallocated,
+//  so building text of n bytes does no copy of already written text.
+//  Result is copied once into weu_string of exact size or written to file
+//  chunk by chunk with weu_io_writeStringBuilder.
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ALLOCATION
+
+//  chunkSize - bytes per chunk, 0 for WEU_STRINGBUILDER_CHUNK
+WEUDEF weu_stringBuilder *weu_stringBuilder_new(uint32_t chunkSize);
+WEUDEF void weu_stringBuilder_free(weu_stringBuilder **handle);
+//  Drops text, keeps first chunk for reuse.
+WEUDEF void weu_stringBuilder_clear(weu_stringBuilder *b);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  APPEND
+
+WEUDEF void weu_stringBuilder_append(weu_stringBuilder *b, const char *text, uint32_t length);
+WEUDEF void weu_stringBuilder_appendText(weu_stringBuilder *b, const char *text);
+WEUDEF void weu_stringBuilder_appendString(weu_stringBuilder *b, const weu_string *str);
+WEUDEF void weu_stringBuilder_appendChar(weu_stringBuilder *b, char c);
+//  Numbers are formatted with weu_charconv, float is written with shortest digits of double.
+WEUDEF void weu_stringBuilder_appendInt(weu_stringBuilder *b, int64_t val);
+WEUDEF void weu_stringBuilder_appendUInt(weu_stringBuilder *b, uint64_t val);
+WEUDEF void weu_stringBuilder_appendFloat(weu_stringBuilder *b, double val);
+//  printf style formatting, formats into chunk in place when result fits.
+WEUDEF void weu_stringBuilder_appendFormat(weu_stringBuilder *b, const char *format, ...);
+WEUDEF void weu_stringBuilder_appendFormatV(weu_stringBuilder *b, const char *format, va_list args);
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  RESULT
+
+//  Returns NULL if text is longer than weu_string can hold.
+WEUDEF weu_string *weu_stringBuilder_toString(const weu_stringBuilder *b);
+//  Copies text to out, which must hold length bytes, no terminator is written.
+WEUDEF void weu_stringBuilder_copyTo(const weu_stringBuilder *b, char *out);
+
+#ifdef WEU_IMPLEMENTATION
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTERNAL
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//  Chunks have one byte past chunkSize so vsnprintf terminator always fits.
+static void _weu_stringBuilder_addChunk(weu_stringBuilder *b) {
+    if (b->chunkCount == b->chunkCapacity) {
+        b->chunkCapacity = b->chunkCapacity == 0 ? 8 : b->chunkCapacity * 2;
+        b->chunks = (char**)realloc(b->chunks, sizeof(char*) * b->chunkCapacity);
+    }
+    b->chunks[b->chunkCount++] = (char*)malloc((size_t)b->chunkSize + 1);
+    b->used = 0;
+}
+//  Returns space of last chunk, adding new chunk when last one is full.
+static inline char *_weu_stringBuilder_tail(weu_stringBuilder *b, uint32_t *freeOut) {
+    if (b->chunkCount == 0 || b->used == b->chunkSize) _weu_stringBuilder_addChunk(b);
+    *freeOut = b->chunkSize - b->used;
+    return b->chunks[b->chunkCount - 1] + b->used;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ALLOCATION
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+weu_stringBuilder *weu_stringBuilder_new(uint32_t chunkSize) {
+    weu_stringBuilder *out = (weu_stringBuilder*)calloc(1, sizeof(weu_stringBuilder));
+    out->chunkSize = chunkSize > 0 ? chunkSize : WEU_STRINGBUILDER_CHUNK;
+    return out;
+}
+void weu_stringBuilder_free(weu_stringBuilder **handle) {
+    weu_stringBuilder *b = *handle;
+    if (b == NULL) return;
+    for (uint32_t i = 0; i < b->chunkCount; i++) free(b->chunks[i]);
+    free(b->chunks);
+    free(b);
+    *handle = NULL;
+}
+void weu_stringBuilder_clear(weu_stringBuilder *b) {
+    if (b == NULL) return;
+    for (uint32_t i = 1; i < b->chunkCount; i++) free(b->chunks[i]);
+    if (b->chunkCount > 1) b->chunkCount = 1;
+    b->used     = 0;
+    b->length   = 0;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  APPEND
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void weu_stringBuilder_append(weu_stringBuilder *b, const char *text, uint32_t length) {
+    if (b == NULL || text == NULL) return;
+    b->length += length;
+    while (length > 0) {
+        uint32_t space;
+        char *tail = _weu_stringBuilder_tail(b, &space);
+        uint32_t n = length < space ? length : space;
+        memcpy(tail, text, n);
+        b->used += n;
+        text    += n;
+        length  -= n;
+    }
+}
+void weu_stringBuilder_appendText(weu_stringBuilder *b, const char *text) {
+    if (text == NULL) return;
+    weu_stringBuilder_append(b, text, (uint32_t)strlen(text));
+}
+void weu_stringBuilder_appendString(weu_stringBuilder *b, const weu_string *str) {
+    if (str == NULL) return;
+    weu_stringBuilder_append(b, str->text, str->length);
+}
+void weu_stringBuilder_appendChar(weu_stringBuilder *b, char c) {
+    if (b == NULL) return;
+    uint32_t space;
+    char *tail = _weu_stringBuilder_tail(b, &space);
+    *tail = c;
+    ++b->used;
+    ++b->length;
+}
+void weu_stringBuilder_appendUInt(weu_stringBuilder *b, uint64_t val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    weu_stringBuilder_append(b, buffer, weu_charconv_formatUInt(buffer, val));
+}
+void weu_stringBuilder_appendInt(weu_stringBuilder *b, int64_t val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    weu_stringBuilder_append(b, buffer, weu_charconv_formatInt(buffer, val));
+}
+void weu_stringBuilder_appendFloat(weu_stringBuilder *b, double val) {
+    char buffer[WEU_CHARCONV_BUFFER];
+    weu_stringBuilder_append(b, buffer, weu_charconv_formatDouble(buffer, val));
+}
+void weu_stringBuilder_appendFormatV(weu_stringBuilder *b, const char *format, va_list args) {
+    if (b == NULL || format == NULL) return;
+    uint32_t space;
+    char *tail = _weu_stringBuilder_tail(b, &space);
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(tail, (size_t)space + 1, format, copy);
+    va_end(copy);
+    if (length < 0) return;
+    if ((uint32_t)length <= space) {
+        b->used     += (uint32_t)length;
+        b->length   += (uint32_t)length;
+        return;
+    }
+    //  Result spans chunks, format once more into temporary buffer
+    char stackBuffer[1024];
+    char *buffer = (size_t)length < sizeof(stackBuffer) ? stackBuffer : (char*)malloc((size_t)length + 1);
+    vsnprintf(buffer, (size_t)length + 1, format, args);
+    weu_stringBuilder_append(b, buffer, (uint32_t)length);
+    if (buffer != stackBuffer) free(buffer);
+}
+void weu_stringBuilder_appendFormat(weu_stringBuilder *b, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    weu_stringBuilder_appendFormatV(b, format, args);
+    va_end(args);
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  RESULT
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+weu_string *weu_stringBuilder_toString(const weu_stringBuilder *b) {
+    if (b == NULL || b->length > UINT32_MAX - 1) return NULL;
+    weu_string *out = weu_string_newSize((uint32_t)b->length);
+    weu_stringBuilder_copyTo(b, out->text);
+    return out;
+}
+void weu_stringBuilder_copyTo(const weu_stringBuilder *b, char *out) {
+    if (b == NULL || out == NULL) return;
+    for (uint32_t i = 0; i < b->chunkCount; i++) {
+        uint32_t length = i + 1 < b->chunkCount ? b->chunkSize : b->used;
+        memcpy(out, b->chunks[i], length);
+        out += length;
+    }
+}
+
+#endif
+#endif
@@ -0,0 +1,181 @@
+/*///////////////////////////////////////////////////////////////////////////////////
+//  SPDX-License-Identifier: Unlicense
+/////////////////////////////////////////////////////////////////////////////////////
+//  USAGE
+//  Functions are defined as extern.
+//  To implement somewhere in source file before including header file
+//  #define WEU_IMPLEMENTATION
+//  Implementation should be defined once.
+//
+//  #define WEU_IMPLEMENTATION
+//  #include <path_to_lib/weu_master.h>
+//
+//  To include all weu library in souce file at once, include weu_master.h
+*////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef weu_stringpool_h
+#define weu_stringpool_h
+
+#define WEUDEF extern
+
+#include "weu_hashtable.h"
+
+//  Canonical strings per block, strings of block never move.
+#ifndef WEU_STRINGPOOL_BLOCK
+#define WEU_STRINGPOOL_BLOCK 1024
+#endif
+//  Bytes of text arena chunk, longer texts get chunk of their own.
+#ifndef WEU_STRINGPOOL_CHUNK
+#define WEU_STRINGPOOL_CHUNK 65536
+#endif
+
+//  Interning pool, text is copied once per distinct byte sequence and gets 32 bit symbol.
+//  Symbols are dense, 0 to count - 1 in interning order, so they can index arrays
+//  or be used as keys of WEU_HASHKEY_INT32 hashtable in place of text keys.
+//  Canonical strings returned by pool are owned by pool and live until pool is freed,
+//  two of them hold same text only when they are same pointer.
+//  Canonical strings have allocLength 0 like slices and must not be edited or freed.
+
+//  count - expected distinct strings, 0 for default
+WEUDEF weu_stringPool *weu_stringPool_new(uint32_t count);
+WEUDEF void weu_stringPool_free(weu_stringPool **handle);
+
+//  Returns symbol of text, adds text to pool if it is not there yet.
+WEUDEF uint32_t weu_stringPool_intern(weu_stringPool *pool, const char *text, uint32_t length);
+//  Returns canonical string of text, adds text to pool if it is not there yet.
+WEUDEF const weu_string *weu_stringPool_internString(weu_stringPool *pool, const char *text, uint32_t length);
+//  Returns symbol of text or WEU_INDEX_INVALID if text was never interned.
+WEUDEF uint32_t weu_stringPool_find(const weu_stringPool *pool, const char *text, uint32_t length);
+//  Returns canonical string of symbol or NULL if symbol is out of range.
+WEUDEF const weu_string *weu_stringPool_get(const weu_stringPool *pool, uint32_t symbol);
+
+#ifdef WEU_IMPLEMENTATION
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTERNAL
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline weu_string *_weu_stringPool_string(const weu_stringPool *pool, uint32_t symbol) {
+    return &pool->strings[symbol / WEU_STRINGPOOL_BLOCK][symbol % WEU_STRINGPOOL_BLOCK];
+}
+//  Returns slot of text, or empty slot it would go to.
+static uint32_t _weu_stringPool_slot(const weu_stringPool *pool, const char *text, uint32_t length, uint64_t hash) {
+    uint32_t mask = pool->length - 1;
+    for (uint32_t i = (uint32_t)hash & mask;; i = (i + 1) & mask) {
+        const weu_hashSlot *slot = &pool->slots[i];
+        if (slot->entry == WEU_HASHITEM_EMPTY) return i;
+        if (slot->hash != (uint32_t)hash) continue;
+        const weu_string *s = _weu_stringPool_string(pool, slot->entry);
+        if (s->length == length && memcmp(s->text, text, length) == 0) return i;
+    }
+}
+static void _weu_stringPool_grow(weu_stringPool *pool, uint32_t length) {
+    weu_hashSlot *slots = (weu_hashSlot*)malloc(sizeof(weu_hashSlot) * length);
+    for (uint32_t i = 0; i < length; i++) slots[i].entry = WEU_HASHITEM_EMPTY;
+    //  Cached hash fragment gives home slot, texts are not rehashed
+    uint32_t mask = length - 1;
+    for (uint32_t i = 0; i < pool->length; i++) {
+        weu_hashSlot slot = pool->slots[i];
+        if (slot.entry == WEU_HASHITEM_EMPTY) continue;
+        uint32_t j = slot.hash & mask;
+        while (slots[j].entry != WEU_HASHITEM_EMPTY) j = (j + 1) & mask;
+        slots[j] = slot;
+    }
+    free(pool->slots);
+    pool->slots = slots;
+    pool->length = length;
+}
+//  Copies text into arena, returns stable address of copy.
+static char *_weu_stringPool_store(weu_stringPool *pool, const char *text, uint32_t length) {
+    uint32_t size = length + 1;
+    char *out;
+    if (size > WEU_STRINGPOOL_CHUNK / 4) {
+        //  Own chunk goes before filled chunk so filled chunk stays last
+        out = (char*)malloc(size);
+        pool->chunks = (char**)realloc(pool->chunks, sizeof(char*) * (pool->chunkCount + 1));
+        if (pool->chunkCount > 0) pool->chunks[pool->chunkCount] = pool->chunks[pool->chunkCount - 1];
+        pool->chunks[pool->chunkCount > 0 ? pool->chunkCount - 1 : 0] = out;
+        if (pool->chunkCount++ == 0) pool->chunkUsed = pool->chunkSize = size;
+    } else {
+        if (pool->chunkCount == 0 || pool->chunkUsed + size > pool->chunkSize) {
+            pool->chunks = (char**)realloc(pool->chunks, sizeof(char*) * (pool->chunkCount + 1));
+            pool->chunks[pool->chunkCount++] = (char*)malloc(WEU_STRINGPOOL_CHUNK);
+            pool->chunkSize = WEU_STRINGPOOL_CHUNK;
+            pool->chunkUsed = 0;
+        }
+        out = pool->chunks[pool->chunkCount - 1] + pool->chunkUsed;
+        pool->chunkUsed += size;
+    }
+    memcpy(out, text, length);
+    out[length] = '\0';
+    pool->bytes += size;
+    return out;
+}
+static uint32_t _weu_stringPool_intern(weu_stringPool *pool, const char *text, uint32_t length) {
+    if (text == NULL) text = "";
+    uint64_t hash = weu_hash_wy(text, length, pool->seed);
+    uint32_t i = _weu_stringPool_slot(pool, text, length, hash);
+    if (pool->slots[i].entry != WEU_HASHITEM_EMPTY) return pool->slots[i].entry;
+    if ((uint64_t)(pool->count + 1) * 100 > (uint64_t)pool->length * WEU_HASHTABLE_MAX_LOAD) {
+        _weu_stringPool_grow(pool, pool->length * 2);
+        i = _weu_stringPool_slot(pool, text, length, hash);
+    }
+    uint32_t symbol = pool->count;
+    if (symbol % WEU_STRINGPOOL_BLOCK == 0) {
+        pool->strings = (weu_string**)realloc(pool->strings, sizeof(weu_string*) * (pool->blockCount + 1));
+        pool->strings[pool->blockCount++] = (weu_string*)malloc(sizeof(weu_string) * WEU_STRINGPOOL_BLOCK);
+    }
+    *_weu_stringPool_string(pool, symbol) = (weu_string){.length = length, .text = _weu_stringPool_store(pool, text, length)};
+    pool->slots[i] = (weu_hashSlot){.entry = symbol, .hash = (uint32_t)hash};
+    ++pool->count;
+    return symbol;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ALLOCATION
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+weu_stringPool *weu_stringPool_new(uint32_t count) {
+    weu_stringPool *out = (weu_stringPool*)calloc(1, sizeof(weu_stringPool));
+    uint32_t length = MIN_TABLE_SIZE;
+    while ((uint64_t)length * WEU_HASHTABLE_MAX_LOAD < (uint64_t)count * 100) length *= 2;
+    out->length = length;
+    out->slots  = (weu_hashSlot*)malloc(sizeof(weu_hashSlot) * length);
+    for (uint32_t i = 0; i < length; i++) out->slots[i].entry = WEU_HASHITEM_EMPTY;
+    out->seed   = weu_hash_randomSeed();
+    return out;
+}
+void weu_stringPool_free(weu_stringPool **handle) {
+    weu_stringPool *pool = *handle;
+    if (pool == NULL) return;
+    for (uint32_t i = 0; i < pool->blockCount; i++) free(pool->strings[i]);
+    for (uint32_t i = 0; i < pool->chunkCount; i++) free(pool->chunks[i]);
+    free(pool->strings);
+    free(pool->chunks);
+    free(pool->slots);
+    free(pool);
+    *handle = NULL;
+}
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+//  DATA
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t weu_stringPool_intern(weu_stringPool *pool, const char *text, uint32_t length) {
+    if (pool == NULL || (text == NULL && length > 0)) return WEU_INDEX_INVALID;
+    return _weu_stringPool_intern(pool, text, length);
+}
+const weu_string *weu_stringPool_internString(weu_stringPool *pool, const char *text, uint32_t length) {
+    if (pool == NULL || (text == NULL && length > 0)) return NULL;
+    return _weu_stringPool_string(pool, _weu_stringPool_intern(pool, text, length));
+}
+uint32_t weu_stringPool_find(const weu_stringPool *pool, const char *text, uint32_t length) {
+    if (pool == NULL || (text == NULL && length > 0)) return WEU_INDEX_INVALID;
+    if (text == NULL) text = "";
+    return pool->slots[_weu_stringPool_slot(pool, text, length, weu_hash_wy(text, length, pool->seed))].entry;
+}
+const weu_string *weu_stringPool_get(const weu_stringPool *pool, uint32_t symbol) {
+    if (pool == NULL || symbol >= pool->count) return NULL;
+    return _weu_stringPool_string(pool, symbol);
+}
+
+#endif
+#endif